@@ -2,18 +2,57 @@
 	@file Sprite.frag
 */
 #version 430
+#ifdef BINDLESS
+#extension GL_ARB_bindless_texture : require
+#endif
 
 layout(location=0) in vec4 inColor;
-layout(location=1) in vec2 inTexCoord;
+layout(location=1) in vec3 inTexCoord;
 
 out vec4 fragColor;
 
+#if defined(BINDLESS)
+layout(location=2) flat in int inDrawId;
+layout(std430, binding=0) readonly buffer TextureHandleTable {
+	uvec2 textureHandles[];	// `R}hƂ̃eNX`Enh(0ȂeNX`Ȃ).
+};
+#elif defined(TEXTURE_ARRAY)
+uniform sampler2DArray texColor;
+#elif defined(TEXTURED)
 uniform sampler2D texColor;
+#endif
+
+/*
+	FZς݃At@ɕϊ.
+*/
+vec4 Premultiply(vec4 c)
+{
+	return vec4(c.rgb * c.a, c.a);
+}
 
 /*
 	XvCgptOgVF[_[.
+
+	_F͏Zς݃At@. eNX`̐FZς݃At@ɕϊĂZ.
+
+	TEXTURED: _FɃeNX`̐FZ. `Ȃ璸_Fo͂.
+	TEXTURE_ARRAY: eNX`WzwԍƂāAzeNX`g.
+	BINDLESS: `R}h̔ԍŃeNX`EnhI.
 */
 void main()
 {
-	fragColor = inColor * texture(texColor, inTexCoord);
+#if defined(BINDLESS)
+	const uvec2 handle = textureHandles[inDrawId];
+	if (handle != uvec2(0)) {
+		fragColor = inColor * Premultiply(texture(sampler2D(handle), inTexCoord.xy));
+	} else {
+		fragColor = inColor;
+	}
+#elif defined(TEXTURE_ARRAY)
+	fragColor = inColor * Premultiply(texture(texColor, inTexCoord));
+#elif defined(TEXTURED)
+	fragColor = inColor * Premultiply(texture(texColor, inTexCoord.xy));
+#else
+	fragColor = inColor;
+#endif
 }
\ No newline at end of file
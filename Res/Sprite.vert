@@ -2,22 +2,47 @@
 	@file Sprite.vert
 */
 #version 430
+#ifdef BINDLESS
+#extension GL_ARB_shader_draw_parameters : require
+#endif
 
-layout(location=0) in vec3 vPostion;
+layout(location=0) in vec3 vPosition;
 layout(location=1) in vec4 vColor;
-layout(location=2) in vec2 vTexCoord;
+layout(location=2) in vec3 vTexCoord;
 
 layout(location=0) out vec4 outColor;
-layout(location=1) out vec2 outTexCoord;
+layout(location=1) out vec3 outTexCoord;
+#ifdef BINDLESS
+layout(location=2) flat out int outDrawId;
+#endif
 
 uniform mat4x4 matMVP;
+uniform int depthBase;	// lp`̔ԍɉl. RenderCommandBufferC[ŏdȂȂ悤Ɋ蓖Ă.
 
 /*
 	XvCgp_VF[_[.
+
+	TEXTURED: eNX`Wo͂.
+	BINDLESS: eNX`IԂ߂ɁA`R}h̔ԍo͂.
+
+	[x͍Wzł͂Ȃ_̕яAォǉlp`قǎOɂ.
+	sȃXvCg[xeXgŐɕ`悵ĂAǉɏd˂ʂƓɂȂ.
+	VAOقȂ`̊ԂłԂۂ悤ɁAdepthBaseŔԍ炷.
 */
 void main()
 {
 	outColor = vColor;
-	outTexoord = vTexCoord;
+#ifdef TEXTURED
+	outTexCoord = vTexCoord;
+#else
+	outTexCoord = vec3(0);
+#endif
+#ifdef BINDLESS
+	outDrawId = gl_DrawIDARB;
+#endif
 	gl_Position = matMVP * vec4(vPosition, 1.0);
+
+	// lp`̔ԍ(1̃C[ōő1048576)-1`+1͈̔͂Ɋ蓖Ă.
+	const float quadIndex = float(depthBase + gl_VertexID / 4);
+	gl_Position.z = (1.0 - (quadIndex + 0.5) / 524288.0) * gl_Position.w;
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+/*
+	@file SpriteInstance.vert
+*/
+#version 430
+
+/*
+	XvCg̃CX^X.
+	GpuSpriteRenderer::InstanceƓ.
+*/
+struct Instance
+{
+	vec4 positionAndRotation;
+	vec4 color;
+	vec4 texRect;
+	vec4 halfSizeAndLayer;
+};
+
+layout(std430, binding=0) readonly buffer InstanceBuffer {
+	Instance instances[];
+};
+layout(std430, binding=1) readonly buffer VisibleIndexBuffer {
+	uint visibleIndices[];
+};
+
+layout(location=0) out vec4 outColor;
+layout(location=1) out vec3 outTexCoord;
+
+uniform mat4x4 matMVP;
+
+// lp`̒_(Op`2). ԂSpriteRenderer̃CfbNXƓ.
+const vec2 corners[6] = vec2[](
+	vec2(-1, -1), vec2(1, -1), vec2(1, 1), vec2(1, 1), vec2(-1, 1), vec2(-1, -1));
+
+/*
+	GPUŕ\肵XvCgp_VF[_[.
+
+	_f[^͎g킸ACX^Xԍƒ_ԍlp`.
+*/
+void main()
+{
+	const Instance e = instances[visibleIndices[gl_InstanceID]];
+	const vec2 corner = corners[gl_VertexID];
+
+	// gE]Esړsg킸ɌvZ.
+	const float c = cos(e.positionAndRotation.w);
+	const float s = sin(e.positionAndRotation.w);
+	const vec2 v = corner * e.halfSizeAndLayer.xy;
+	const vec2 position = e.positionAndRotation.xy + vec2(c * v.x - s * v.y, s * v.x + c * v.y);
+
+	outColor = e.color;
+	outTexCoord = vec3(e.texRect.xy + (corner * 0.5 + 0.5) * e.texRect.zw, e.halfSizeAndLayer.z);
+	gl_Position = matMVP * vec4(position, e.positionAndRotation.z, 1.0);
+}
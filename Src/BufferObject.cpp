@@ -2,6 +2,8 @@
 	@file BufferObject.cpp
 */
 #include "BufferObject.h"
+#include "GpuResourceRegistry.h"
+#include "GLDebug.h"
 #include <iostream>
 
 /*
@@ -18,6 +20,7 @@
 bool BufferObject::Create(
 	GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
 {
+	GL_CALL_SITE();
 	Destroy();
 	glGenBuffers(1, &id);
 	glBindBuffer(target, id);
@@ -25,11 +28,12 @@ bool BufferObject::Create(
 	glBindBuffer(target, 0);
 	this->target = target;
 	this->size = size;
-	const GLenum error = glGetError();
-	if (error != GL_NO_ERROR) {
+	GpuResourceRegistry::Instance().Register(GpuResourceType::Buffer, id, size, "BufferObject::Create");
+	if (!GL_CALL_SUCCEEDED()) {
 		std::cerr << "[G[]" << __func__ << ": obt@̍쐬Ɏs.\n";
+		return false;
 	}
-	return error == GL_NO_ERROR;
+	return true;
 }
 
 /*
@@ -44,7 +48,7 @@ bool BufferObject::Create(
 */
 bool BufferObject::BufferSubData(GLintptr offset, GLsizeiptr size, const GLvoid* data)
 {
-	if (offset + size >= this->size) {
+	if (offset + size > this->size) {
 		std::cerr << "[x]" << __func__ << ":]̈悪obt@TCYzĂ܂.\n"
 			<< " buffer size:" << this->size << "offset:" << " size:" << size << "\n";
 		if (offset >= this->size) {
@@ -53,14 +57,15 @@ bool BufferObject::BufferSubData(GLintptr offset, GLsizeiptr size, const GLvoid*
 		// \Ȕ͈͂]s.
 		size = this->size - offset;
 	}
+	GL_CALL_SITE();
 	glBindBuffer(target, id);
 	glBufferSubData(target, offset, size, data);
 	glBindBuffer(target, 0);
-	const GLenum error = glGetError();
-	if (error != GL_NO_ERROR) {
+	if (!GL_CALL_SUCCEEDED()) {
 		std::cerr << "[G[] " << __func__ << ": f[^̓]Ɏs.\n";
+		return false;
 	}
-	return error == GL_NO_ERROR;
+	return true;
 }
 
 /*
@@ -69,6 +74,7 @@ bool BufferObject::BufferSubData(GLintptr offset, GLsizeiptr size, const GLvoid*
 void BufferObject::Destroy()
 {
 	if (id) {
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Buffer, id);
 		glDeleteBuffers(1, &id);
 		id = 0;
 	}
@@ -86,6 +92,7 @@ void BufferObject::Destroy()
 
 bool VertexArrayObject::Create(GLuint vbo, GLuint ibo)
 {
+	GL_CALL_SITE();
 	Destroy();
 	glGenVertexArrays(1, &id);
 	glBindVertexArray(id);
@@ -95,11 +102,13 @@ bool VertexArrayObject::Create(GLuint vbo, GLuint ibo)
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	vboId = vbo;
 	iboId = ibo;
-	const GLenum error = glGetError();
-	if (error != GL_NO_ERROR) {
+	GpuResourceRegistry::Instance().Register(GpuResourceType::VertexArray, id, 0,
+		"VertexArrayObject::Create");
+	if (!GL_CALL_SUCCEEDED()) {
 		std::cerr << "[G[]" << __func__ << ": VAO̍쐬Ɏs.\n";
+		return false;
 	}
-	return error == GL_NO_ERROR;
+	return true;
 }
 
 /*
@@ -109,6 +118,7 @@ bool VertexArrayObject::Create(GLuint vbo, GLuint ibo)
 void VertexArrayObject::Destroy()
 {
 	if (id) {
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::VertexArray, id);
 		glDeleteVertexArrays(1, &id);
 		id = 0;
 		vboId = 0;
@@ -0,0 +1,102 @@
+/*
+	@file Camera2D.cpp
+*/
+#include "Camera2D.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+/*
+	RXgN^.
+
+	@param x		r[|[g̍XW.
+	@param y		r[|[g̍YW.
+	@param width	r[|[g̕.
+	@param height	r[|[g̍.
+*/
+Camera2D::Camera2D(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	Viewport(x, y, width, height);
+}
+
+/*
+	r[|[gݒ肷.
+
+	@param x		r[|[g̍XW.
+	@param y		r[|[g̍YW.
+	@param width	r[|[g̕.
+	@param height	r[|[g̍.
+
+	\͈͂́Ar[|[g̑傫g嗦Ŋ傫ɂȂ.
+*/
+void Camera2D::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	viewport[0] = x;
+	viewport[1] = y;
+	viewport[2] = width;
+	viewport[3] = height;
+	isDirty = true;
+}
+
+/*
+	r[EvWFNVs擾.
+
+	@return r[EvWFNVs.
+*/
+const glm::mat4& Camera2D::ViewProjectionMatrix() const
+{
+	if (isDirty) {
+		Update();
+	}
+	return matVP;
+}
+
+/*
+	\͈͂擾.
+
+	@return \͈͂͂ދ`. ]Ăꍇ́A]\͈͂͂ދ`ɂȂ.
+
+	SpriteGrid::Query()Ȃǂ̉Ɏg.
+*/
+const Rect& Camera2D::VisibleRect() const
+{
+	if (isDirty) {
+		Update();
+	}
+	return visibleRect;
+}
+
+/*
+	r[|[gOpenGLReLXgɐݒ肷.
+*/
+void Camera2D::ApplyViewport() const
+{
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+/*
+	sƕ\͈͂vZ.
+*/
+void Camera2D::Update() const
+{
+	// seA_̓r[|[g̒S.
+	const glm::vec2 halfSize = glm::vec2(
+		static_cast<float>(viewport[2]), static_cast<float>(viewport[3])) * (0.5f / zoom);
+	const glm::mat4 matProj = glm::ortho(
+		-halfSize.x, halfSize.x, -halfSize.y, halfSize.y, 1.0f, 1000.0f);
+
+	// xNg]邱ƂŁAJ].
+	const float c = std::cos(rotation);
+	const float s = std::sin(rotation);
+	const glm::mat4 matView = glm::lookAt(glm::vec3(position, 100),
+		glm::vec3(position, 0), glm::vec3(-s, c, 0));
+	matVP = matProj * matView;
+
+	// ]\͈͂͂ދ`vZ.
+	const glm::vec2 extent(
+		std::abs(c) * halfSize.x + std::abs(s) * halfSize.y,
+		std::abs(s) * halfSize.x + std::abs(c) * halfSize.y);
+	visibleRect.origin = position - extent;
+	visibleRect.size = extent * 2.0f;
+
+	isDirty = false;
+}
@@ -0,0 +1,59 @@
+/*
+	@file Camera2D.h
+*/
+#ifndef CAMERA2D_H_INCLUDED
+#define CAMERA2D_H_INCLUDED
+#include "Geometry.h"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/*
+	2D`p̃J.
+
+	s͐ݒ肪ύXꂽƁAŏɕKvɂȂƂvZ.
+	1̃J𕡐SpriteRendererŋLł.
+	قȂr[|[g̃JœSpriteRenderer`悷΁A
+	_f[^蒼ɉʕ~j}bv\ł.
+*/
+class Camera2D
+{
+public:
+	Camera2D() = default;
+	Camera2D(GLint x, GLint y, GLsizei width, GLsizei height);
+	~Camera2D() = default;
+
+	// _̐ݒE擾.
+	void Position(const glm::vec2& p) { position = p; isDirty = true; }
+	const glm::vec2& Position() const { return position; }
+
+	// g嗦̐ݒE擾(2.0 = 2{Ɋg債ĕ\).
+	void Zoom(float z) { zoom = z; isDirty = true; }
+	float Zoom() const { return zoom; }
+
+	// ]px(WA)̐ݒE擾.
+	void Rotation(float r) { rotation = r; isDirty = true; }
+	float Rotation() const { return rotation; }
+
+	// r[|[g̐ݒE擾.
+	void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+	const GLint* Viewport() const { return viewport; }
+
+	const glm::mat4& ViewProjectionMatrix() const;
+	const Rect& VisibleRect() const;
+	void ApplyViewport() const;
+
+private:
+	void Update() const;
+
+	glm::vec2 position = glm::vec2(0);
+	float zoom = 1;
+	float rotation = 0;
+	GLint viewport[4] = { 0, 0, 1, 1 };
+
+	// vZʂ̃LbV.
+	mutable bool isDirty = true;
+	mutable glm::mat4 matVP;
+	mutable Rect visibleRect;
+};
+
+#endif // CAMERA2D_H_INCLUDED
@@ -0,0 +1,456 @@
+/*
+	@file Font.cpp
+*/
+#include "Font.h"
+#include "QuadIndexBuffer.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+namespace /* unnamed */ {
+
+/*
+	BMFont1s͂.
+
+	@param line		͂s.
+	@param tag		s̎(擪̒P)i[ϐ.
+	@param attr		"O=l"̑gi[ϐ. l͂ވp͎菜.
+*/
+void ParseLine(const std::string& line, std::string& tag,
+	std::unordered_map<std::string, std::string>& attr)
+{
+	attr.clear();
+	size_t i = line.find_first_not_of(" \t");
+	if (i == std::string::npos) {
+		tag.clear();
+		return;
+	}
+	size_t end = line.find_first_of(" \t", i);
+	tag = line.substr(i, end - i);
+	i = end;
+	while (i < line.size()) {
+		i = line.find_first_not_of(" \t\r", i);
+		if (i == std::string::npos) {
+			break;
+		}
+		const size_t equal = line.find('=', i);
+		if (equal == std::string::npos) {
+			break;
+		}
+		const std::string key = line.substr(i, equal - i);
+		i = equal + 1;
+		if (i < line.size() && line[i] == '"') {
+			end = line.find('"', i + 1);
+			attr[key] = line.substr(i + 1, end - i - 1);
+			i = end == std::string::npos ? end : end + 1;
+		} else {
+			end = line.find_first_of(" \t\r", i);
+			attr[key] = line.substr(i, end - i);
+			i = end;
+		}
+	}
+}
+
+/*
+	̒l𐮐ƂĎ擾.
+*/
+int ToInt(std::unordered_map<std::string, std::string>& attr, const char* key)
+{
+	return atoi(attr[key].c_str());
+}
+
+} // unnamed namespace
+
+/*
+	tHg`NX.
+
+	@param maxCharacterCount	`\ȍő啶(Œ蕶܂).
+	@param vsPath				_VF[_[t@C.
+	@param fsPath				tOgVF[_[t@C.
+
+	@retval true	.
+	@retval false	s.
+*/
+bool FontRenderer::Init(size_t maxCharacterCount, const char* vsPath, const char* fsPath)
+{
+	GPU_RESOURCE_SITE();
+	QuadIndexBuffer& ibo = QuadIndexBuffer::Instance();
+	maxQuadCount = ibo.Reserve(maxCharacterCount);
+	if (maxQuadCount < maxCharacterCount) {
+		std::cerr << "[x]" << __func__ << ": " << maxQuadCount <<
+			"𒴂镶͕`ł܂.\n";
+	}
+	vbo.Create(GL_ARRAY_BUFFER, sizeof(Vertex) * maxQuadCount * 4, nullptr, GL_STREAM_DRAW);
+	vao.Create(vbo.Id(), ibo.Id());
+	vao.Bind();
+	vao.VertexAttribPointer(
+		0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, position));
+	vao.VertexAttribPointer(
+		1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, color));
+	vao.VertexAttribPointer(
+		2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, texCoord));
+	vao.Unbind();
+
+	Shader::Permutation textured;
+	textured.features = Shader::Feature_Textured;
+	program = Shader::ProgramCache::Instance().Get(vsPath, fsPath, textured);
+
+	vertices.reserve(maxQuadCount * 4);
+	if (!vbo.Id() || !vao.Id() || !program || !program->Id()) {
+		return false;
+	}
+	return true;
+}
+
+/*
+	tHgt@Cǂݍ.
+
+	@param filename	BMFont`(eLXg)̃tHgt@C.
+
+	@retval true	ǂݍݐ.
+	@retval false	ǂݍݎs.
+
+	y[W摜̓tHgt@CƓtH_ǂݍ.
+*/
+bool FontRenderer::LoadFromFile(const char* filename)
+{
+	std::ifstream ifs(filename);
+	if (!ifs.is_open()) {
+		std::cerr << "[G[]" << __func__ << ": " << filename << "J܂.\n";
+		return false;
+	}
+	std::string folder(filename);
+	const size_t separator = folder.find_last_of("/\\");
+	folder.resize(separator == std::string::npos ? 0 : separator + 1);
+
+	pages.clear();
+	glyphs.clear();
+	kernings.clear();
+	glm::vec2 textureSize(1);
+	std::string line;
+	std::string tag;
+	std::unordered_map<std::string, std::string> attr;
+	while (std::getline(ifs, line)) {
+		ParseLine(line, tag, attr);
+		if (tag == "common") {
+			lineHeight = static_cast<float>(ToInt(attr, "lineHeight"));
+			textureSize = glm::vec2(ToInt(attr, "scaleW"), ToInt(attr, "scaleH"));
+			pages.resize(ToInt(attr, "pages"));
+		} else if (tag == "page") {
+			const size_t id = ToInt(attr, "id");
+			if (id >= pages.size()) {
+				pages.resize(id + 1);
+			}
+			const std::string path = folder + attr["file"];
+			pages[id] = Texture::Image2D::Create(path.c_str());
+			if (!pages[id]->Get()) {
+				std::cerr << "[G[]" << __func__ << ": " << path << "ǂݍ߂܂.\n";
+				return false;
+			}
+		} else if (tag == "char") {
+			const int id = ToInt(attr, "id");
+			if (id < 0 || id > 0xffff) {
+				continue;
+			}
+			if (static_cast<size_t>(id) >= glyphs.size()) {
+				glyphs.resize(id + 1);
+			}
+			// BMFont̍W͍㌴_Ȃ̂ŁAeNX`W(_)ɕϊ.
+			Glyph& g = glyphs[id];
+			g.isValid = true;
+			g.page = static_cast<uint8_t>(ToInt(attr, "page"));
+			g.size = glm::vec2(ToInt(attr, "width"), ToInt(attr, "height"));
+			g.offset = glm::vec2(ToInt(attr, "xoffset"), ToInt(attr, "yoffset"));
+			g.xadvance = static_cast<float>(ToInt(attr, "xadvance"));
+			g.uv = glm::vec2(static_cast<float>(ToInt(attr, "x")),
+				textureSize.y - static_cast<float>(ToInt(attr, "y")) - g.size.y) / textureSize;
+			g.uvSize = g.size / textureSize;
+		} else if (tag == "kerning") {
+			const uint32_t first = ToInt(attr, "first") & 0xffff;
+			const uint32_t second = ToInt(attr, "second") & 0xffff;
+			kernings[(first << 16) | second] = static_cast<float>(ToInt(attr, "amount"));
+		}
+	}
+	if (pages.empty() || glyphs.empty()) {
+		std::cerr << "[G[]" << __func__ << ": " << filename << "̓tHgt@Cł͂܂.\n";
+		return false;
+	}
+	return true;
+}
+
+/*
+	̏擾.
+
+	@param c	.
+
+	@return ̏. tHgɊ܂܂ȂȂnullptr.
+*/
+const FontRenderer::Glyph* FontRenderer::FindGlyph(wchar_t c) const
+{
+	const size_t i = static_cast<size_t>(c);
+	if (i >= glyphs.size() || !glyphs[i].isValid || glyphs[i].page >= pages.size()) {
+		return nullptr;
+	}
+	return &glyphs[i];
+}
+
+/*
+	2̊̕Ԋu̕␳l擾.
+
+	@param first	O̕.
+	@param second	̕.
+
+	@return ␳l(sNZ).
+*/
+float FontRenderer::Kerning(wchar_t first, wchar_t second) const
+{
+	if (kernings.empty() || !first) {
+		return 0;
+	}
+	const uint32_t key = ((static_cast<uint32_t>(first) & 0xffff) << 16) |
+		(static_cast<uint32_t>(second) & 0xffff);
+	const auto itr = kernings.find(key);
+	return itr != kernings.end() ? itr->second : 0;
+}
+
+/*
+	zuĒ_f[^쐬.
+
+	@param position		1sڂ̍̍W.
+	@param str			. '\n'ŉs.
+	@param vertices		_f[^ǉz.
+	@param runs			y[W͈͂̕ǉz.
+	@param maxQuadCount	verticesɊi[łő啶.
+
+	@retval true	ǉ.
+	@retval false	ő啶𒴂߁Aꕔ̕ǉłȂ.
+*/
+bool FontRenderer::Layout(const glm::vec2& position, const wchar_t* str,
+	std::vector<Vertex>& vertices, std::vector<Run>& runs, size_t maxQuadCount) const
+{
+	const glm::vec4 c(glm::vec3(color) * color.w, color.w);
+	glm::vec2 pen = position;
+	wchar_t prev = 0;
+	for (; *str; ++str) {
+		if (*str == L'\n') {
+			pen.x = position.x;
+			pen.y -= lineHeight * scale.y;
+			prev = 0;
+			continue;
+		}
+		const Glyph* g = FindGlyph(*str);
+		if (!g) {
+			prev = 0;
+			continue;
+		}
+		pen.x += Kerning(prev, *str) * scale.x;
+		prev = *str;
+
+		// 󔒂ȂǁA傫̂Ȃ͈ʒui߂邾.
+		if (g->size.x > 0 && g->size.y > 0) {
+			if (vertices.size() / 4 >= maxQuadCount) {
+				std::cerr << "[x]" << __func__ << ": ő啶𒴂Ă܂.\n";
+				return false;
+			}
+			const float x0 = pen.x + g->offset.x * scale.x;
+			const float x1 = x0 + g->size.x * scale.x;
+			const float y1 = pen.y - g->offset.y * scale.y;
+			const float y0 = y1 - g->size.y * scale.y;
+			const glm::vec2 uv1 = g->uv + g->uvSize;
+			vertices.push_back({ glm::vec3(x0, y0, 0), c, glm::vec3(g->uv.x, g->uv.y, 0) });
+			vertices.push_back({ glm::vec3(x1, y0, 0), c, glm::vec3(uv1.x, g->uv.y, 0) });
+			vertices.push_back({ glm::vec3(x1, y1, 0), c, glm::vec3(uv1.x, uv1.y, 0) });
+			vertices.push_back({ glm::vec3(x0, y1, 0), c, glm::vec3(g->uv.x, uv1.y, 0) });
+			if (runs.empty() || runs.back().page != g->page) {
+				runs.push_back({ g->page, 0 });
+			}
+			++runs.back().quadCount;
+		}
+		pen.x += g->xadvance * scale.x;
+	}
+	return true;
+}
+
+/*
+	\Ƃ̑傫vZ.
+
+	@param str	.
+
+	@return łs̕ƁAs~s̍.
+*/
+glm::vec2 FontRenderer::Measure(const wchar_t* str) const
+{
+	glm::vec2 size(0, lineHeight * scale.y);
+	float x = 0;
+	wchar_t prev = 0;
+	for (; *str; ++str) {
+		if (*str == L'\n') {
+			size.x = std::max(size.x, x);
+			size.y += lineHeight * scale.y;
+			x = 0;
+			prev = 0;
+			continue;
+		}
+		const Glyph* g = FindGlyph(*str);
+		if (!g) {
+			prev = 0;
+			continue;
+		}
+		x += (Kerning(prev, *str) + g->xadvance) * scale.x;
+		prev = *str;
+	}
+	size.x = std::max(size.x, x);
+	return size;
+}
+
+/*
+	Œ蕶ǉ.
+
+	@param position	1sڂ̍̍W.
+	@param str		. '\n'ŉs.
+
+	@retval true	ǉ.
+	@retval false	ő啶𒴂߁Aꕔ̕ǉłȂ.
+
+	Œ蕶ClearStaticStrings()ĂԂ܂ŕ\ꑱ. zu͒ǉ1񂾂sA
+	_f[^͎EndUpdate()œ].
+*/
+bool FontRenderer::AddStaticString(const glm::vec2& position, const wchar_t* str)
+{
+	isStaticDirty = true;
+	return Layout(position, str, staticVertices, staticRuns, maxQuadCount);
+}
+
+/*
+	SĂ̌Œ蕶.
+*/
+void FontRenderer::ClearStaticStrings()
+{
+	staticVertices.clear();
+	staticRuns.clear();
+	isStaticDirty = true;
+}
+
+/*
+	t[̒̕ǉJn.
+*/
+void FontRenderer::BeginUpdate()
+{
+	vertices.clear();
+	dynamicRuns.clear();
+}
+
+/*
+	ǉ.
+
+	@param position	1sڂ̍̍W.
+	@param str		. '\n'ŉs.
+
+	@retval true	ǉ.
+	@retval false	ő啶𒴂߁Aꕔ̕ǉłȂ.
+*/
+bool FontRenderer::AddString(const glm::vec2& position, const wchar_t* str)
+{
+	const size_t staticQuadCount = staticVertices.size() / 4;
+	return Layout(position, str, vertices, dynamicRuns,
+		maxQuadCount - std::min(staticQuadCount, maxQuadCount));
+}
+
+/*
+	̒ǉIA_f[^].
+
+	Œ蕶͕ύXƂ].
+*/
+void FontRenderer::EndUpdate()
+{
+	const size_t staticBytes = std::min(staticVertices.size(), maxQuadCount * 4) * sizeof(Vertex);
+	if (isStaticDirty) {
+		isStaticDirty = false;
+		if (staticBytes) {
+			vbo.BufferSubData(0, staticBytes, staticVertices.data());
+		}
+	}
+	if (!vertices.empty()) {
+		vbo.BufferSubData(staticBytes, vertices.size() * sizeof(Vertex), vertices.data());
+	}
+
+	// Œ蕶Ɩt[̕͘AĂ̂ŁAEœy[WȂ1ɂ܂Ƃ߂.
+	runs = staticRuns;
+	for (const Run& e : dynamicRuns) {
+		if (!runs.empty() && runs.back().page == e.page) {
+			runs.back().quadCount += e.quadCount;
+		} else {
+			runs.push_back(e);
+		}
+	}
+}
+
+/*
+	`悷.
+
+	@param camera	`ɎgpJ.
+
+	r[|[g̓J̐ݒɕύX.
+*/
+void FontRenderer::Draw(const Camera2D& camera) const
+{
+	if (runs.empty()) {
+		return;
+	}
+	camera.ApplyViewport();
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	vao.Bind();
+	program->Use();
+	program->SetViewProjectionMatrix(camera.ViewProjectionMatrix());
+	size_t first = 0;
+	for (const Run& e : runs) {
+		pages[e.page]->MarkUsed();
+		program->BindTexture(0, pages[e.page]->Get());
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(e.quadCount * 6), GL_UNSIGNED_SHORT,
+			reinterpret_cast<const GLvoid*>(first * 6 * sizeof(GLushort)));
+		first += e.quadCount;
+	}
+	program->BindTexture(0, 0);
+	vao.Unbind();
+}
+
+/*
+	̕`R}h쐬.
+
+	@param buffer	R}hǉobt@.
+	@param camera	`ɎgpJ.
+	@param layer	`惌C[.
+*/
+void FontRenderer::Draw(RenderCommandBuffer& buffer, const Camera2D& camera, uint8_t layer) const
+{
+	if (runs.empty()) {
+		return;
+	}
+	const uint16_t view = buffer.AddView(camera.ViewProjectionMatrix(), camera.Viewport());
+	size_t quadCount = 0;
+	for (const Run& e : runs) {
+		quadCount += e.quadCount;
+	}
+	const GLint depthBase = buffer.AllocateDepth(layer, quadCount);
+	size_t first = 0;
+	for (const Run& e : runs) {
+		const GLuint texture = pages[e.page]->Get();
+		pages[e.page]->MarkUsed();
+		RenderCommand command;
+		command.sortKey = RenderCommandBuffer::MakeSortKey(layer, program->Id(), texture,
+			static_cast<uint32_t>(depthBase + first));
+		command.program = program.get();
+		command.vao = vao.Id();
+		command.texture = texture;
+		command.count = static_cast<GLsizei>(e.quadCount * 6);
+		command.offset = first * 6 * sizeof(GLushort);
+		command.view = view;
+		command.depthBase = depthBase;
+		buffer.Add(command);
+		first += e.quadCount;
+	}
+}
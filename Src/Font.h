@@ -0,0 +1,107 @@
+/*
+	@file Font.h
+*/
+#ifndef FONT_H_INCLUDED
+#define FONT_H_INCLUDED
+#include "BufferObject.h"
+#include "Texture.h"
+#include "Shader.h"
+#include "Camera2D.h"
+#include "RenderCommandBuffer.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <stdint.h>
+
+/*
+	rbg}bvEtHg`NX.
+
+	BMFont`(eLXg)̃tHgt@CTGA`̃y[W摜ǂݍ݁A
+	lp`̕тƂĕ`悷. SĂ̕1̒_obt@ɂ܂Ƃ߂A
+	y[W͈͂̕1̕`ŏ.
+
+	AddStaticString()Œǉ͒_f[^ێ邽߁At[zuKvȂ.
+	BeginUpdate()`EndUpdate()Œǉ́ABeginUpdate()ŏ.
+*/
+class FontRenderer
+{
+public:
+	FontRenderer() = default;
+	~FontRenderer() = default;
+	FontRenderer(const FontRenderer&) = delete;
+	FontRenderer& operator=(const FontRenderer&) = delete;
+
+	bool Init(size_t maxCharacterCount, const char* vsPath, const char* fsPath);
+	bool LoadFromFile(const char* filename);
+
+	bool AddStaticString(const glm::vec2& position, const wchar_t* str);
+	void ClearStaticStrings();
+
+	void BeginUpdate();
+	bool AddString(const glm::vec2& position, const wchar_t* str);
+	void EndUpdate();
+
+	void Draw(const Camera2D&) const;
+	void Draw(RenderCommandBuffer&, const Camera2D&, uint8_t layer) const;
+
+	// ǉ镶̐FƊg嗦. ǉς݂̕ɂ͉eȂ.
+	void Color(const glm::vec4& c) { color = c; }
+	const glm::vec4& Color() const { return color; }
+	void Scale(const glm::vec2& s) { scale = s; }
+	const glm::vec2& Scale() const { return scale; }
+
+	float LineHeight() const { return lineHeight * scale.y; }
+	glm::vec2 Measure(const wchar_t* str) const;
+
+private:
+	struct Vertex {
+		glm::vec3 position;	///< W.
+		glm::vec4 color;	///< F(Zς݃At@).
+		glm::vec3 texCoord;	///< eNX`W. SpriteRendererƓVF[_[g3vf.
+	};
+
+	// ̏. R[hYƂzɊi[.
+	struct Glyph {
+		bool isValid = false;	///< tHgɊ܂܂镶.
+		uint8_t page = 0;		///< y[Wԍ.
+		glm::vec2 uv = glm::vec2(0);		///< ̃eNX`W.
+		glm::vec2 uvSize = glm::vec2(0);	///< eNX`W̑傫.
+		glm::vec2 size = glm::vec2(0);		///< 傫(sNZ).
+		glm::vec2 offset = glm::vec2(0);	///< `ʒu獶܂ł̋(sNZ, ).
+		float xadvance = 0;		///< ̕܂ł̋(sNZ).
+	};
+
+	// y[W͈̕.
+	struct Run {
+		uint8_t page;
+		size_t quadCount;
+	};
+
+	const Glyph* FindGlyph(wchar_t c) const;
+	float Kerning(wchar_t first, wchar_t second) const;
+	bool Layout(const glm::vec2& position, const wchar_t* str,
+		std::vector<Vertex>& vertices, std::vector<Run>& runs, size_t maxQuadCount) const;
+
+	BufferObject vbo;
+	VertexArrayObject vao;
+	Shader::ProgramPtr program;
+	std::vector<Texture::Image2DPtr> pages;	///< y[W摜.
+	std::vector<Glyph> glyphs;				///< R[hYƂ镶̏.
+	std::unordered_map<uint32_t, float> kernings;	///< (O̕ << 16 | ̕)Ԋu̕␳l.
+	float lineHeight = 0;	///< s̍(sNZ).
+	glm::vec4 color = glm::vec4(1);
+	glm::vec2 scale = glm::vec2(1);
+
+	size_t maxQuadCount = 0;	///< _obt@Ɋi[ł镶.
+
+	// _obt@̐擪Œ蕶Ǎɖt[̕i[.
+	std::vector<Vertex> staticVertices;
+	std::vector<Run> staticRuns;
+	bool isStaticDirty = false;	///< Œ蕶]Kv邩.
+	std::vector<Vertex> vertices;
+	std::vector<Run> dynamicRuns;
+	std::vector<Run> runs;		///< `悷͈. Œ蕶Ɩt[̕܂Ƃ߂.
+};
+
+#endif // FONT_H_INCLUDED
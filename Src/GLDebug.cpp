@@ -0,0 +1,218 @@
+/*
+	@file GLDebug.cpp
+*/
+#include "GLDebug.h"
+#include <iostream>
+
+namespace GLDebug {
+
+namespace /* unnamed */ {
+
+Handler handler;			///< bZ[W̏o͐. ȂWG[o.
+size_t errorCount = 0;		///< 񍐂ꂽG[̐.
+
+#ifdef _DEBUG
+const CallSite* currentSite = nullptr;	///< ł̌Ăяoʒu.
+bool isCallbackEnabled = false;			///< KHR_debug̃R[obNL.
+
+/*
+	̖O擾.
+
+	@param source	.
+
+	@return ̖O.
+*/
+const char* SourceName(GLenum source)
+{
+	switch (source) {
+	case GL_DEBUG_SOURCE_API: return "API";
+	case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "WindowSystem";
+	case GL_DEBUG_SOURCE_SHADER_COMPILER: return "ShaderCompiler";
+	case GL_DEBUG_SOURCE_THIRD_PARTY: return "ThirdParty";
+	case GL_DEBUG_SOURCE_APPLICATION: return "Application";
+	default: return "Other";
+	}
+}
+
+/*
+	ނ̖O擾.
+
+	@param type	.
+
+	@return ނ̖O.
+*/
+const char* TypeName(GLenum type)
+{
+	switch (type) {
+	case GL_DEBUG_TYPE_ERROR: return "Error";
+	case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "Deprecated";
+	case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "Undefined";
+	case GL_DEBUG_TYPE_PORTABILITY: return "Portability";
+	case GL_DEBUG_TYPE_PERFORMANCE: return "Performance";
+	default: return "Other";
+	}
+}
+
+/*
+	dvx̖O擾.
+
+	@param severity	dvx.
+
+	@return dvx̖O.
+*/
+const char* SeverityName(GLenum severity)
+{
+	switch (severity) {
+	case GL_DEBUG_SEVERITY_HIGH: return "High";
+	case GL_DEBUG_SEVERITY_MEDIUM: return "Medium";
+	case GL_DEBUG_SEVERITY_LOW: return "Low";
+	default: return "Notification";
+	}
+}
+
+/*
+	bZ[WWG[o͂ɏo.
+
+	@param m	obZ[W.
+
+	1̃bZ[W1sɂ܂Ƃ߁Aڂ"O=l"̌`ŕׂ.
+*/
+void DefaultHandler(const Message& m)
+{
+	std::cerr << (m.type == GL_DEBUG_TYPE_ERROR ? "[G[]" : "[x]") << "OpenGL:" <<
+		" source=" << SourceName(m.source) << " type=" << TypeName(m.type) <<
+		" id=0x" << std::hex << m.id << std::dec << " severity=" << SeverityName(m.severity);
+	if (m.file) {
+		std::cerr << " site=" << m.file << "(" << m.line << ") " << m.function;
+	}
+	std::cerr << " message=\"" << m.text << "\"\n";
+}
+
+/*
+	bZ[WL^.
+
+	@param m	L^郁bZ[W. Ăяoʒu͂Őݒ肷.
+*/
+void Log(Message& m)
+{
+	if (currentSite) {
+		m.file = currentSite->file;
+		m.line = currentSite->line;
+		m.function = currentSite->function;
+	}
+	if (m.type == GL_DEBUG_TYPE_ERROR) {
+		++errorCount;
+	}
+	if (handler) {
+		handler(m);
+	} else {
+		DefaultHandler(m);
+	}
+}
+
+/*
+	KHR_debug̃bZ[W.
+
+	o͂LɂĂ̂ŁAG[NOpenGL֐̒Ă΂.
+*/
+void GLAPIENTRY DebugCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+	GLsizei length, const GLchar* message, const void* userParam)
+{
+	Message m = { source, type, id, severity, message, nullptr, 0, nullptr };
+	Log(m);
+}
+#endif
+
+} // unnamed namespace
+
+/*
+	G[񍐂.
+
+	@retval true	. [Xrhł͏ɐ.
+	@retval false	KHR_debuggȂ. CallSiteglGetError()ŃG[𒲂ׂ.
+
+	OpenGLReLXg쐬AGLEWŌĂяo.
+*/
+bool Init()
+{
+#ifdef _DEBUG
+	if (!GLEW_VERSION_4_3 && !GLEW_KHR_debug) {
+		std::cerr << "[x]" << __func__ << ": KHR_debugɑΉĂ܂. " <<
+			"glGetError()ŃG[𒲂ׂ܂.\n";
+		return false;
+	}
+	glEnable(GL_DEBUG_OUTPUT);
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glDebugMessageCallback(DebugCallback, nullptr);
+	// ʒm͗ʂ̂Ŏ󂯎Ȃ.
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION,
+		0, nullptr, GL_FALSE);
+	isCallbackEnabled = true;
+#endif
+	return true;
+}
+
+/*
+	bZ[W̏o͐ݒ肷.
+
+	@param h	bZ[W󂯎֐. ȂWG[o͂ɖ߂.
+*/
+void SetHandler(const Handler& h)
+{
+	handler = h;
+}
+
+/*
+	񍐂ꂽG[̐擾.
+
+	@return G[̐. [Xrhł͏0.
+*/
+size_t ErrorCount()
+{
+	return errorCount;
+}
+
+#ifdef _DEBUG
+/*
+	RXgN^.
+
+	@param file		t@C.
+	@param line		sԍ.
+	@param function	֐.
+*/
+CallSite::CallSite(const char* file, int line, const char* function) :
+	file(file), line(line), function(function), prev(currentSite), errorCount(ErrorCount())
+{
+	currentSite = this;
+}
+
+/*
+	fXgN^.
+*/
+CallSite::~CallSite()
+{
+	currentSite = prev;
+}
+
+/*
+	쐬ĂG[NĂȂׂ.
+
+	@retval true	G[Ȃ.
+	@retval false	G[.
+
+	KHR_debuggȂꍇ́AglGetError()ĂŃG[L^.
+*/
+bool CallSite::Succeeded() const
+{
+	if (!isCallbackEnabled) {
+		for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError()) {
+			Message m = { GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_ERROR, error,
+				GL_DEBUG_SEVERITY_HIGH, "glGetError", nullptr, 0, nullptr };
+			Log(m);
+		}
+	}
+	return ErrorCount() == errorCount;
+}
+#endif
+
+} // namespace GLDebug
@@ -0,0 +1,81 @@
+/*
+	@file GLDebug.h
+*/
+#ifndef GLDEBUG_H_INCLUDED
+#define GLDEBUG_H_INCLUDED
+#include <GL/glew.h>
+#include <functional>
+#include <string>
+#include <stddef.h>
+
+/*
+	OpenGL̃G[񍐂O.
+
+	fobOrhłKHR_debug̃R[obNŃG[󂯎AĂяoʒuƈꏏɋL^.
+	[Xrhł̓G[𒲂ׂ鏈̓RpCɎ菜AglGetError()Ă΂Ȃ.
+*/
+namespace GLDebug {
+
+	/*
+		OpenGL񍐂ꂽbZ[W.
+	*/
+	struct Message
+	{
+		GLenum source;			///< (GL_DEBUG_SOURCE_*).
+		GLenum type;			///< (GL_DEBUG_TYPE_*).
+		GLuint id;				///< bZ[Wԍ.
+		GLenum severity;		///< dvx(GL_DEBUG_SEVERITY_*).
+		std::string text;		///< bZ[W{.
+		const char* file;		///< Ăяoʒũt@C. sȂnullptr.
+		int line;				///< Ăяoʒu̍sԍ.
+		const char* function;	///< Ăяoʒů֐. sȂnullptr.
+	};
+	using Handler = std::function<void(const Message&)>;
+
+	bool Init();
+	void SetHandler(const Handler&);
+	size_t ErrorCount();
+
+#ifdef _DEBUG
+	/*
+		OpenGLĂяo֐̈ʒuL^NX.
+
+		ڎg킸GL_CALL_SITE()}Ng.
+	*/
+	class CallSite
+	{
+	public:
+		CallSite(const char* file, int line, const char* function);
+		~CallSite();
+		CallSite(const CallSite&) = delete;
+		CallSite& operator=(const CallSite&) = delete;
+
+		bool Succeeded() const;
+
+		const char* file;		///< t@C.
+		int line;				///< sԍ.
+		const char* function;	///< ֐.
+
+	private:
+		const CallSite* prev;	///< ǑĂяoʒu.
+		size_t errorCount;		///< 쐬_̃G[.
+	};
+#endif
+
+} // namespace GLDebug
+
+/*
+	̍s܂ރubNŔOpenGL̃G[A̍s̈ʒuŕ񍐂.
+
+	GL_CALL_SUCCEEDED()́AubN̊JnG[NĂȂtrueɂȂ.
+	[Xrhł͂ǂAGL_CALL_SUCCEEDED()͏trueɂȂ.
+*/
+#ifdef _DEBUG
+#define GL_CALL_SITE() GLDebug::CallSite glCallSite_(__FILE__, __LINE__, __func__)
+#define GL_CALL_SUCCEEDED() (glCallSite_.Succeeded())
+#else
+#define GL_CALL_SITE() ((void)0)
+#define GL_CALL_SUCCEEDED() (true)
+#endif
+
+#endif // GLDEBUG_H_INCLUDED
@@ -2,7 +2,10 @@
 	@file GLFWEW.cpp
 */
 #include "GLFWEW.h"
+#include "GLDebug.h"
 #include <iostream>
+#include <thread>
+#include <chrono>
 
 // GLFWGLEWbv邽߂̖O.
 
@@ -75,17 +78,27 @@ bool Window::Init(int w, int h, const char* title)
 	}
 
 		if (!window) {
+			glfwWindowHint(GLFW_VISIBLE, isHidden ? GLFW_FALSE : GLFW_TRUE);
+#ifdef _DEBUG
+			// fobOrhł́AG[KHR_debugŎ󂯎悤ɂ.
+			glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 			window = glfwCreateWindow(w, h, title, nullptr, nullptr);
 			if (!window) {
 				return false;
 			}
 			glfwMakeContextCurrent(window);
+			glfwSetKeyCallback(window, KeyCallback);
+			glfwSetJoystickCallback(JoystickCallback);
+			isJoystickPresent = glfwJoystickPresent(GLFW_JOYSTICK_1) == GLFW_TRUE;
 		}
+		ApplySwapInterval();
 
 		if (glewInit() != GLEW_OK) {
 			std::cerr << "ERORR: GLEW̏Ɏs܂." << std::endl;
 			return false;
 		}
+		GLDebug::Init();
 
 		width = w;
 		height = h;
@@ -114,11 +127,90 @@ bool Window::Init(int w, int h, const char* title)
 
 	/*
 		tgobt@ƃobNobt@؂ւ.
+
+		ڕWt[[gݒ肳ĂꍇÃt[̊Jn܂őҋ@.
+		x[hł̓Cxg̎擾UpdataTimer()܂Œx点.
 	*/
-	void Window::SwapBuffers() const
+	void Window::SwapBuffers()
 	{
-		glfwPollEvents();
+		if (!isLowLatencyMode) {
+			PollEvents();
+		}
 		glfwSwapBuffers(window);
+		WaitForNextFrame();
+	}
+
+	/*
+		̊Ԋuݒ肷.
+
+		@param interval	0 = Ȃ.
+						1ȏ = w肵񐔂̐҂.
+						-1 = A_veBu(ԂɍȂt[͂ɕ\).
+
+		A_veBuɑΉĂȂł́A1ݒ肳.
+	*/
+	void Window::SetSwapInterval(int interval)
+	{
+		swapInterval = interval;
+		if (window) {
+			ApplySwapInterval();
+		}
+	}
+
+	/*
+		̊ԊuOpenGLReLXgɔf.
+	*/
+	void Window::ApplySwapInterval()
+	{
+		if (swapInterval < 0) {
+			if (!glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+				!glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+				std::cerr << "[x]" << __func__ << ": A_veBuɑΉĂ܂.\n";
+				swapInterval = 1;
+			}
+		}
+		glfwSwapInterval(swapInterval);
+	}
+
+	/*
+		ڕWt[[gݒ肷.
+
+		@param fps	1b̃t[. 0ȉȂ琧Ȃ.
+	*/
+	void Window::SetTargetFps(double fps)
+	{
+		targetFrameTime = fps > 0 ? 1.0 / fps : 0.0;
+		nextFrameTime = glfwGetTime();
+	}
+
+	/*
+		̃t[̊Jn܂őҋ@.
+
+		OS̃X[v͐xႢ߁AJn̏O܂ł̓X[vA
+		c̎Ԃ̓Xsđ҂.
+	*/
+	void Window::WaitForNextFrame()
+	{
+		if (targetFrameTime <= 0) {
+			return;
+		}
+		nextFrameTime += targetFrameTime;
+		const double currentTime = glfwGetTime();
+
+		// ԂɍȂꍇA҂ɊJnݎɍ킹.
+		if (nextFrameTime <= currentTime) {
+			nextFrameTime = currentTime;
+			return;
+		}
+
+		const double spinTime = 0.002;	// Xső҂.
+		const double sleepTime = nextFrameTime - currentTime - spinTime;
+		if (sleepTime > 0) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
+		}
+		while (glfwGetTime() < nextFrameTime) {
+			std::this_thread::yield();
+		}
 	}
 	
 	/*
@@ -168,102 +260,268 @@ bool Window::Init(int w, int h, const char* title)
 		GAMEPAD_BUTTON_LEFT,	///< L[.
 	};
 
+	// zCfbNXGamePadL[̑Ή\.
+	static const struct {
+		int dataIndex;
+		uint32_t gamepadBit;
+	} padButtonMap[] = {
+		{ GAMEPAD_BUTTON_A, GamePad::A },
+		{ GAMEPAD_BUTTON_B, GamePad::B },
+		{ GAMEPAD_BUTTON_X, GamePad::X },
+		{ GAMEPAD_BUTTON_Y, GamePad::Y },
+		{ GAMEPAD_BUTTON_L, GamePad::L },
+		{ GAMEPAD_BUTTON_R, GamePad::R },
+		{ GAMEPAD_BUTTON_START, GamePad::START },
+		{ GAMEPAD_BUTTON_UP, GamePad::DPAD_UP },
+		{ GAMEPAD_BUTTON_DOWN, GamePad::DPAD_DOWN },
+		{ GAMEPAD_BUTTON_LEFT, GamePad::DPAD_LEFT },
+		{ GAMEPAD_BUTTON_RIGHT, GamePad::DPAD_RIGHT },
+	};
+
+	// L[R[hGamePadL[̑Ή\.
+	static const struct {
+		int keyCode;
+		uint32_t gamepadBit;
+	} keyButtonMap[] = {
+		{ GLFW_KEY_J, GamePad::A },
+		{ GLFW_KEY_K, GamePad::B },
+		{ GLFW_KEY_U, GamePad::X },
+		{ GLFW_KEY_I, GamePad::Y },
+		{ GLFW_KEY_O, GamePad::L },
+		{ GLFW_KEY_L, GamePad::R },
+		{ GLFW_KEY_ENTER, GamePad::START },
+		{ GLFW_KEY_W, GamePad::DPAD_UP },
+		{ GLFW_KEY_A, GamePad::DPAD_DOWN },
+		{ GLFW_KEY_S, GamePad::DPAD_LEFT },
+		{ GLFW_KEY_D, GamePad::DPAD_RIGHT },
+	};
+
 	/*
-		Q[pbh̏ԂXVB
+		GamePadL[̃rbgԍ擾.
+
+		@param bit	GamePadL[̃rbg.
+
+		@return rbgԍ. ΉrbgȂꍇ-1.
 	*/
-	void Window::UpdateGamePad()
+	int GamePadBitIndex(uint32_t bit)
 	{
-		// buttonDown𐶐邽߂ɁAXVO̓͏ԂۑĂB
-		const uint32_t prevButtons = gamepad.buttons;
+		for (int i = 0; i < Window::gamepadButtonCount; ++i) {
+			if (bit == (1U << i)) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/*
+		L[͂CxgL[ɒǉ.
+
+		GLFW̃L[̓R[obNƂāAglfwPollEvents()̒Ă΂.
+	*/
+	void Window::KeyCallback(GLFWwindow*, int key, int scancode, int action, int mods)
+	{
+		if (action == GLFW_REPEAT) {
+			return;
+		}
+		Instance().inputQueue.Push({
+			InputEvent::Key, key, static_cast<float>(action), glfwGetTime() });
+	}
+
+	/*
+		Q[pbh̐ڑԂL^.
+
+		GLFW̃WCXeBbNER[obNƂāAglfwPollEvents()̒Ă΂.
+	*/
+	void Window::JoystickCallback(int jid, int event)
+	{
+		if (jid == GLFW_JOYSTICK_1) {
+			Instance().isJoystickPresent = event == GLFW_CONNECTED;
+		}
+	}
+
+	/*
+		OSCxg擾A̓CxgL[ɒǉ.
+
+		L[{[h̓R[obNŃCxg󂯎.
+		GLFW̓Q[pbh̃R[obNȂ̂ŁAڑĂꍇԂ擾A
+		O񂩂ωCxgƂăL[ɒǉ.
+	*/
+	void Window::PollEvents()
+	{
+		glfwPollEvents();
+		if (!isJoystickPresent) {
+			if (isJoystickValid) {
+				isJoystickValid = false;
+				inputQueue.Push({ InputEvent::JoystickConnection, 0, 0, glfwGetTime() });
+			}
+			return;
+		}
 
 		// AiO͂ƃ{^͂擾B
 		int axesCount, buttonCount;
 		const float * axes = glfwGetJoystickAxes(GLFW_JOYSTICK_1, &axesCount);
 		const uint8_t * buttons = glfwGetJoystickButtons(GLFW_JOYSTICK_1,&buttonCount);
-		
-		// o̔znullptrł͂ȂA
+
+		// o͂̔znullptrł͂ȂA
 		// ŒKvȃf[^𖞑Ă΁ALȃQ[pbh
 		// ڑĂƂƂłB
-		if (axes && buttons && axesCount >= 2 && buttonCount >= 8) {
-			// LȃQ[pbhڑĂꍇ
-
-			// L[̓͏ԂāAXeBbN̓͂ŒuB
-			gamepad.buttons &= ~(GamePad::DPAD_UP | GamePad::DPAD_DOWN | GamePad::DPAD_LEFT | GamePad::DPAD_RIGHT);
-			static const float digitalThreshold = 0.3f;	// fW^͂Ƃ݂ȂAl.
-			if (axes[GAMEPAD_AXES_LEFT_Y] >= digitalThreshold) {
-				gamepad.buttons |= GamePad::DPAD_UP;
-			}
-			else if (axes[GAMEPAD_AXES_LEFT_Y] <= -digitalThreshold) {
-				gamepad.buttons |= GamePad::DPAD_DOWN;
+		const bool isValid = axes && buttons && axesCount >= 2 && buttonCount >= 8;
+		const double time = glfwGetTime();
+		if (isValid != isJoystickValid) {
+			isJoystickValid = isValid;
+			inputQueue.Push({ InputEvent::JoystickConnection, 0, isValid ? 1.0f : 0.0f, time });
+			for (uint8_t& e : prevJoystickButtons) {
+				e = GLFW_RELEASE;
 			}
-			if (axes[GAMEPAD_AXES_LEFT_X] >= digitalThreshold) {
-				gamepad.buttons |= GamePad::DPAD_LEFT;
+			prevJoystickAxes[0] = prevJoystickAxes[1] = 0;
+		}
+		if (!isValid) {
+			return;
+		}
+
+		for (int i = 0; i < 2; ++i) {
+			if (axes[i] != prevJoystickAxes[i]) {
+				prevJoystickAxes[i] = axes[i];
+				inputQueue.Push({ InputEvent::JoystickAxis, i, axes[i], time });
 			}
-			else if (axes[GAMEPAD_AXES_LEFT_X] <= -digitalThreshold) {
-				gamepad.buttons |= GamePad::DPAD_RIGHT;
+		}
+		for (const auto& e : padButtonMap) {
+			if (e.dataIndex < buttonCount && buttons[e.dataIndex] != prevJoystickButtons[e.dataIndex]) {
+				prevJoystickButtons[e.dataIndex] = buttons[e.dataIndex];
+				inputQueue.Push({ InputEvent::JoystickButton, e.dataIndex,
+					static_cast<float>(buttons[e.dataIndex]), time });
 			}
+		}
+	}
+
+	/*
+		Q[pbh̏ԂXVB
+
+		L[ɗ܂̓CxgԂɓKpāAGamePad̏Ԃč\z.
+		1t[ZԂŉėꂽ{^AbuttonDownɂ͋L^.
+	*/
+	void Window::UpdateGamePad()
+	{
+		// Đ͓̓CxĝĂāAL^ꂽԂg.
+		if (replayer.IsPlaying()) {
+			InputEvent e;
+			while (inputQueue.Pop(e)) {}
+			gamepad = replayGamePad;
+			return;
+		}
 
-			// zCfbNXGamePadL[̑Ή\.
-			static const struct {
-				int dataIndex;
-				uint32_t gamepadBit;
-			} keyMap[] = {
-				{ GAMEPAD_BUTTON_A, GamePad::A },
-				{ GAMEPAD_BUTTON_B, GamePad::B },
-				{ GAMEPAD_BUTTON_X, GamePad::X },
-				{ GAMEPAD_BUTTON_Y, GamePad::Y },
-				{ GAMEPAD_BUTTON_L, GamePad::L },
-				{ GAMEPAD_BUTTON_R, GamePad::R },
-				{ GAMEPAD_BUTTON_START, GamePad::START },
-				{ GAMEPAD_BUTTON_UP, GamePad::DPAD_UP },
-				{ GAMEPAD_BUTTON_DOWN, GamePad::DPAD_DOWN },
-				{ GAMEPAD_BUTTON_LEFT, GamePad::DPAD_LEFT },
-				{ GAMEPAD_BUTTON_RIGHT, GamePad::DPAD_RIGHT },
-			};
-
-			for (const auto& e : keyMap) {
-				if (buttons[e.dataIndex] == GLFW_PRESS) {
-					gamepad.buttons |= e.gamepadBit;
+		// buttonDown𐶐邽߂ɁAXVO̓͏ԂۑĂB
+		const uint32_t prevButtons = gamepad.buttons;
+		uint32_t pressedButtons = 0;
+
+		InputEvent e;
+		while (inputQueue.Pop(e)) {
+			uint32_t* target = nullptr;
+			uint32_t bit = 0;
+			switch (e.type) {
+			case InputEvent::Key:
+				for (const auto& m : keyButtonMap) {
+					if (m.keyCode == e.code) {
+						target = &keyButtons;
+						bit = m.gamepadBit;
+						break;
+					}
 				}
-				else if (buttons[e.dataIndex] == GLFW_RELEASE) {
-					gamepad.buttons &= ~e.gamepadBit;
+				break;
+
+			case InputEvent::JoystickButton:
+				for (const auto& m : padButtonMap) {
+					if (m.dataIndex == e.code) {
+						target = &padButtons;
+						bit = m.gamepadBit;
+						break;
+					}
 				}
-			}
-		}
-		else {
-			// LȃQ[pbhڑĂȂ̂ŁAL[{[h͂őp.
-
-			// zCfbNXGamePadL[̑Ή\.
-			static const struct {
-				int keyCode;
-				uint32_t gamepadBit;
-			} keyMap[] = {
-				{ GLFW_KEY_J, GamePad::A },
-				{ GLFW_KEY_K, GamePad::B },
-				{ GLFW_KEY_U, GamePad::X },
-				{ GLFW_KEY_I, GamePad::Y },
-				{ GLFW_KEY_O, GamePad::L },
-				{ GLFW_KEY_L, GamePad::R },
-				{ GLFW_KEY_ENTER, GamePad::START },
-				{ GLFW_KEY_W, GamePad::DPAD_UP },
-				{ GLFW_KEY_A, GamePad::DPAD_DOWN },
-				{ GLFW_KEY_S, GamePad::DPAD_LEFT },
-				{ GLFW_KEY_D, GamePad::DPAD_RIGHT },
-		};
-
-			for (const auto& e : keyMap) {
-				const int key = glfwGetKey(window, e.keyCode);
-				if (key == GLFW_PRESS) {
-					gamepad.buttons |= e.gamepadBit;
+				break;
+
+			case InputEvent::JoystickAxis: {
+				// XeBbN̓͂L[ƂĈ.
+				static const float digitalThreshold = 0.3f;	// fW^͂Ƃ݂ȂAl.
+				const uint32_t positive =
+					e.code == GAMEPAD_AXES_LEFT_Y ? GamePad::DPAD_UP : GamePad::DPAD_LEFT;
+				const uint32_t negative =
+					e.code == GAMEPAD_AXES_LEFT_Y ? GamePad::DPAD_DOWN : GamePad::DPAD_RIGHT;
+				const uint32_t prevStick = padStickButtons;
+				padStickButtons &= ~(positive | negative);
+				if (e.value >= digitalThreshold) {
+					padStickButtons |= positive;
+				}
+				else if (e.value <= -digitalThreshold) {
+					padStickButtons |= negative;
+				}
+				if (isJoystickConnected) {
+					const uint32_t down = padStickButtons & ~prevStick;
+					pressedButtons |= down;
+					for (int i = 0; i < gamepadButtonCount; ++i) {
+						if (down & (1U << i)) {
+							buttonDownTime[i] = e.time;
+						}
+					}
 				}
-				else if (key == GLFW_RELEASE) {
-					gamepad.buttons &= ~e.gamepadBit;
+				break;
+			}
+
+			case InputEvent::JoystickConnection:
+				isJoystickConnected = e.value != 0;
+				padButtons = 0;
+				padStickButtons = 0;
+				break;
+			}
+
+			if (!target) {
+				continue;
+			}
+			if (e.value == GLFW_PRESS) {
+				*target |= bit;
+
+				// Lȓ͑ũCxgȂAꂽuԂƎL^.
+				if ((target == &padButtons) == isJoystickConnected) {
+					pressedButtons |= bit;
+					const int index = GamePadBitIndex(bit);
+					if (index >= 0) {
+						buttonDownTime[index] = e.time;
+					}
 				}
 			}
+			else if (e.value == GLFW_RELEASE) {
+				*target &= ~bit;
+			}
+		}
+
+		// LȃQ[pbhڑĂȂ΁AL[{[h͂őp.
+		if (isJoystickConnected) {
+			gamepad.buttons = padButtons | padStickButtons;
+		}
+		else {
+			gamepad.buttons = keyButtons;
 		}
 
 		// O̍XVŉĂȂāA񉟂ĂL[̏buttonDownɊi[.
-		gamepad.buttonDown = gamepad.buttons & ~prevButtons;
+		// ĂꂽL[܂߂.
+		gamepad.buttonDown = (gamepad.buttons & ~prevButtons) | pressedButtons;
+	}
+
+	/*
+		{^ꂽ擾.
+
+		@param button	ׂ{^(GamePad::AȂ).
+
+		@return Ōbuttonꂽ(b). ꂽƂȂΕ.
+
+		DeltaTime()glfwGetTime()Ɣr邱ƂŁAt[̂ǂ̎_ŉꂽ킩.
+	*/
+	double Window::ButtonDownTime(uint32_t button) const
+	{
+		const int index = GamePadBitIndex(button);
+		if (index < 0) {
+			return -1;
+		}
+		return buttonDownTime[index];
 	}
 
 	/*
@@ -288,7 +546,10 @@ bool Window::Init(int w, int h, const char* title)
 	{
 		glfwSetTime(0.0);
 		previousTime = 0.0;
+		nextFrameTime = 0.0;
 		deltaTime = 0.0;
+		accumulator = 0.0;
+		stepCount = 0;
 	}
 
 	/*
@@ -296,17 +557,90 @@ bool Window::Init(int w, int h, const char* title)
 	*/
 	void Window::UpdataTimer()
 	{
+		// x[hł́A͂ł邾XV̒OɎ擾.
+		if (isLowLatencyMode) {
+			PollEvents();
+		}
+
 		// oߎԂv.
 		const double currentTime = glfwGetTime();
 		deltaTime = currentTime - previousTime;
 		previousTime = currentTime;
 
-		// oߎԂȂ肷Ȃ悤ɒ.
-		const float upperLimit = 0.25f;	// oߎԂƂċe.
-		if (deltaTime > upperLimit) {
-			deltaTime = 1.0f / 60.0f;
+		// Đ͎ۂ̌oߎԂ𓝌vpɋL^AL^ꂽoߎԂɒu.
+		if (replayer.IsPlaying()) {
+			replayer.AddFrameTime(deltaTime);
+			if (!replayer.Next(replayGamePad, deltaTime)) {
+				replayGamePad = GamePad();
+				glfwSetWindowShouldClose(window, GLFW_TRUE);
+			}
 		}
+		const double frameDeltaTime = deltaTime;
+
+		// buttonDownpꍇ̂߂ɁAXVȌԂۑĂ.
+		const uint32_t prevButtonDown = gamepad.buttonDown;
+		const int prevStepCount = stepCount;
+		stepCount = 0;
 		UpdateGamePad();
+
+		// ŒXebv̏ꍇAoߎԂ~ς NextFixedStep() ŏ.
+		if (IsFixedTimeStep()) {
+			accumulator += deltaTime;
+
+			// ŒǂȂȂ̂h߁AőXebv𒴂镪͎̂Ă.
+			const double upperLimit = fixedDeltaTime * maxStepsPerFrame;
+			if (accumulator > upperLimit) {
+				accumulator = upperLimit;
+			}
+			deltaTime = fixedDeltaTime;
+
+			// Õt[ōXV1sȂꍇAꂽuԂ̏p.
+			if (prevStepCount == 0) {
+				gamepad.buttonDown |= prevButtonDown;
+			}
+		}
+		else {
+			// oߎԂȂ肷Ȃ悤ɒ.
+			const float upperLimit = 0.25f;	// oߎԂƂċe.
+			if (deltaTime > upperLimit) {
+				deltaTime = 1.0f / 60.0f;
+			}
+		}
+
+		if (recorder.IsRecording()) {
+			recorder.Record(gamepad, frameDeltaTime);
+		}
+	}
+
+	/*
+		͂̋L^Jn.
+
+		@param path	L^̃t@C.
+
+		@retval true	Jn.
+		@retval false	Jns.
+
+		ȌAUpdataTimer()̂тɃQ[pbh̏ԂƌoߎԂL^.
+	*/
+	bool Window::StartRecording(const char* path)
+	{
+		return recorder.Begin(path);
+	}
+
+	/*
+		L^͂̍ĐJn.
+
+		@param path	L^t@C.
+
+		@retval true	Jn.
+		@retval false	Jns.
+
+		Đ̓L[{[hQ[pbh̓͂𖳎AL^ꂽ͂ƌoߎԂg.
+		L^̏I[ɒBƃt[Ԃ̓vo͂AShouldClose()trueԂ悤ɂȂ.
+	*/
+	bool Window::StartReplay(const char* path)
+	{
+		return replayer.Load(path);
 	}
 
 	/*
@@ -319,5 +653,63 @@ bool Window::Init(int w, int h, const char* title)
 		return deltaTime;
 	}
 
+	/*
+		ŒXebvɂXVݒ肷.
+
+		@param stepsPerSecond	1b̍XV. 0ȉȂσXebvɖ߂.
+		@param maxSteps			1t[ŎsőXebv.
+
+		ŒXebvł́AUpdataTimer()ŌvoߎԂ~ςA
+		NextFixedStep()trueԂтDeltaTime()b.
+		dőXebvŒǂȂꍇAc̎Ԃ͎̂Ă.
+	*/
+	void Window::SetFixedTimeStep(double stepsPerSecond, int maxSteps)
+	{
+		fixedDeltaTime = stepsPerSecond > 0 ? 1.0 / stepsPerSecond : 0.0;
+		maxStepsPerFrame = maxSteps > 0 ? maxSteps : 1;
+		accumulator = 0.0;
+		stepCount = 0;
+	}
+
+	/*
+		̍XVXebvsׂׂ.
+
+		@retval true	XV1s邱.
+		@retval false	̃t[̍XV͏I.
+
+		σXebv̏ꍇ́AUpdataTimer()̌1񂾂trueԂ.
+		2ڈȍ~̃XebvłbuttonDownāA͂dȂ悤ɂ.
+	*/
+	bool Window::NextFixedStep()
+	{
+		if (!IsFixedTimeStep()) {
+			return stepCount++ == 0;
+		}
+		if (accumulator < fixedDeltaTime) {
+			return false;
+		}
+		accumulator -= fixedDeltaTime;
+		if (stepCount++ > 0) {
+			gamepad.buttonDown = 0;
+		}
+		return true;
+	}
+
+	/*
+		`p̕ԌW擾.
+
+		@return O̍XV玟̍XV܂ł̐i݋(0.0`1.0).
+				σXebv̏ꍇ͏1.0.
+
+		`ł́AȌԂƍ̏Ԃ̒lŕԂƊ炩ɕ\ł.
+	*/
+	double Window::InterpolationAlpha() const
+	{
+		if (!IsFixedTimeStep()) {
+			return 1.0;
+		}
+		return accumulator / fixedDeltaTime;
+	}
+
 
 } // namespeace GLFWEW
\ No newline at end of file
@@ -5,6 +5,8 @@
 #define GLFWEW_H_INCLUDED
 #include <GL/glew.h>
 #include "GamePad.h"
+#include "InputQueue.h"
+#include "InputRecorder.h"
 #include <GLFW/glfw3.h>
 
 namespace GLFWEW {
@@ -18,14 +20,30 @@ namespace GLFWEW {
 		static Window & Instance();
 		bool Init(int w, int h, const char* title);
 		bool ShouldClose() const;
-		void SwapBuffers() const;
+		void SwapBuffers();
+		void SetSwapInterval(int interval);
+		int SwapInterval() const { return swapInterval; }
+		void SetTargetFps(double fps);
+		void SetLowLatencyMode(bool enable) { isLowLatencyMode = enable; }
+		bool IsLowLatencyMode() const { return isLowLatencyMode; }
 
 		void InitTimer();
 		void UpdataTimer();
 		double DeltaTime() const;
+		void SetFixedTimeStep(double stepsPerSecond, int maxSteps = 5);
+		bool IsFixedTimeStep() const { return fixedDeltaTime > 0; }
+		bool NextFixedStep();
+		double InterpolationAlpha() const;
 		int Width() const { return width; }
 		int Height() const { return height; }
 		const GamePad& GetGamePad() const;
+		double ButtonDownTime(uint32_t button) const;
+		bool StartRecording(const char* path);
+		bool StartReplay(const char* path);
+		bool IsReplaying() const { return replayer.IsPlaying(); }
+		void SetHidden(bool hidden) { isHidden = hidden; }
+
+		static const int gamepadButtonCount = 11;	///< GamePad̃{^̎ސ.
 
 		bool IsKeyPressed(int key) const;
 
@@ -35,6 +53,11 @@ namespace GLFWEW {
 		Window(const Window&) = delete;
 		Window & operator = (const Window&) = delete;
 		void UpdateGamePad();
+		void PollEvents();
+		static void KeyCallback(GLFWwindow*, int key, int scancode, int action, int mods);
+		static void JoystickCallback(int jid, int event);
+		void ApplySwapInterval();
+		void WaitForNextFrame();
 
 		bool isGLFWInitialized = false;
 		bool isInitialized = false;
@@ -43,7 +66,39 @@ namespace GLFWEW {
 		int height = 0;
 		double previousTime = 0;
 		double deltaTime = 0;
+		double fixedDeltaTime = 0;	///< ŒXebv̊Ԋu(b). 0ȂσXebv.
+		double accumulator = 0;		///< ܂V~[VĂȂoߎ.
+		int maxStepsPerFrame = 5;	///< 1t[ŎsőXebv.
+		int stepCount = 0;			///< ̃t[ŎsXebv.
 		GamePad gamepad;
+
+		// ̓Cxg. ̓CXbhAUpdateGamePad()ĂԃXbh.
+		InputQueue inputQueue;
+
+		// ̏.
+		bool isJoystickPresent = false;		///< Q[pbhڑĂ邩.
+		bool isJoystickValid = false;		///< LȃQ[pbhƂĈ邩.
+		uint8_t prevJoystickButtons[16] = {};
+		float prevJoystickAxes[2] = {};
+
+		// ̏.
+		bool isJoystickConnected = false;	///< Q[pbh̓͂g.
+		uint32_t keyButtons = 0;			///< L[{[hꂽ{^.
+		uint32_t padButtons = 0;			///< Q[pbh̃{^ꂽ{^.
+		uint32_t padStickButtons = 0;		///< XeBbNꂽ{^.
+		double buttonDownTime[gamepadButtonCount] = {};
+
+		// ͂̋L^ƍĐ.
+		InputRecorder recorder;
+		InputReplayer replayer;
+		GamePad replayGamePad;	///< Đ̃Q[pbh̏.
+		bool isHidden = false;	///< EBhE\ɍ쐬邩.
+
+		int swapInterval = 1;			///< ̊Ԋu. -1ȂA_veBu.
+		double targetFrameTime = 0;		///< ڕWt[(b). 0Ȃ琧Ȃ.
+		double nextFrameTime = 0;		///< ̃t[Jn鎞.
+		bool isLowLatencyMode = false;	///< ͂̎擾XVO܂Œx点邩.
+
 	};
 
 } // namespeace GLFWEW
@@ -5,6 +5,20 @@
 #include "TitleScene.h"
 #include "GLFWEW.h"
 
+/*
+	V[.
+
+	@retval true	.
+
+	߂̃^Cgʂǂ݂Ă.
+*/
+bool GameOverScene::Initialize()
+{
+	nextScene = std::make_shared<TitleScene>();
+	SceneStack::Instance().Preload(nextScene);
+	return true;
+}
+
 /*
 	vC[̓͂.
 */
@@ -15,5 +29,9 @@ void GameOverScene::ProcessInput()
 		SceneStack::Instance().Replace(std::make_shared<GameOverScene>());
 	}
 
-	SceneStack::Instance().Replace(std::make_shared<TitleScene>());
+	// ǂݍ݂ɎsƑJڂ͒~̂ŁAJڂ܂ŗ\񂵒.
+	// ǂ݂śAReplaceNow()̒œIɓǂݍ݂蒼.
+	if (nextScene && !SceneStack::Instance().IsTransitionPending()) {
+		SceneStack::Instance().Replace(nextScene);
+	}
 }
\ No newline at end of file
@@ -14,11 +14,14 @@ public:
 	GameOverScene() : Scene("GameOverScene") {}
 	virtual ~GameOverScene() = default;
 
-	virtual bool Initialize() override { return true; }
+	virtual bool Initialize() override;
 	virtual void ProcessInput() override;
 	virtual void Update(float)override {}
 	virtual void Render() override {}
 	virtual void Finalize() override {}
+
+private:
+	ScenePtr nextScene;	///< ǂ݂ẴV[. Jڂ܂ŕێ.
 };
 
 #endif // GAMEOVERSCENE_H_INCLUDED
\ No newline at end of file
@@ -1,7 +1,7 @@
 /*
 	@file GamePad.h
 */
-# ifndef GAMWPAD_H_INCLUDED
+# ifndef GAMEPAD_H_INCLUDED
 # define GAMEPAD_H_INCLUDED
 # include <stdint.h>
 
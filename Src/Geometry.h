@@ -4,6 +4,7 @@
 #ifndef GEOMETRY_H_INCLUDED
 #define GEOMETRY_H_INCLUDED
 #include <GL/glew.h>
+#include <glm/vec2.hpp>
 
 // 2DxNg^.
 struct Vector2
@@ -43,4 +44,13 @@ struct Mesh
 	GLint baseVertex;		//< CfbNX0ԂƂ݂Ȃ钸_z̈ʒu.
 };
 
+/*
+	`\.
+*/
+struct Rect
+{
+	glm::vec2 origin;	///< _.
+	glm::vec2 size;		///< c̕.
+};
+
 #endif // GEOMETRY_H_INCLUDED
@@ -0,0 +1,389 @@
+/*
+	@file GpuResourceRegistry.cpp
+*/
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <vector>
+#include <iostream>
+
+namespace /* unnamed */ {
+
+/*
+	\[X̎ޖ擾.
+
+	@param type	\[X̎.
+
+	@return ޖ.
+*/
+const char* TypeName(GpuResourceType type)
+{
+	switch (type) {
+	case GpuResourceType::Buffer: return "Buffer";
+	case GpuResourceType::VertexArray: return "VertexArray";
+	case GpuResourceType::Texture: return "Texture";
+	case GpuResourceType::Program: return "Program";
+	default: return "Unknown";
+	}
+}
+
+/*
+	LҖ\pɕϊ.
+
+	@param owner	LҖ.
+
+	@return \p̏LҖ. L҂Ȃ"(Ȃ)".
+*/
+const char* OwnerName(const std::string& owner)
+{
+	return owner.empty() ? "(Ȃ)" : owner.c_str();
+}
+
+} // unnamed namespace
+
+/*
+	WXg擾.
+
+	@return WXg̃VOgCX^X.
+
+	IɂSceneStack⑼̃VOg\[X̂ŁAɔjȂ悤A
+	Ӑ}IɔjȂ܂܂ɂ.
+*/
+GpuResourceRegistry& GpuResourceRegistry::Instance()
+{
+	static GpuResourceRegistry* instance = new GpuResourceRegistry;
+	return *instance;
+}
+
+/*
+	\[Xo^.
+
+	@param type		\[X̎.
+	@param id		OpenGL̃IuWFNgID. 0Ȃ牽Ȃ.
+	@param bytes	GPŨoCg.
+	@param function	쐬֐. GPU_RESOURCE_SITE()Ȃ΍쐬ʒuƂĎg.
+
+	L҂ƍ쐬ʒúAĂяo_OwnerScopeSiteScopê̂ɂȂ.
+	\Z𒴂Ƃ͌xo͂.
+*/
+void GpuResourceRegistry::Register(GpuResourceType type, GLuint id, size_t bytes,
+	const char* function)
+{
+	if (!id) {
+		return;
+	}
+	Unregister(type, id);
+
+	Entry e;
+	e.type = type;
+	e.id = id;
+	e.bytes = 0;
+	e.owner = owner;
+	if (site) {
+		e.site = *site;
+	} else {
+		e.site.function = function;
+	}
+	entries.emplace(Key(type, id), e);
+	Resize(type, id, bytes);
+}
+
+/*
+	\[X̃oCgύX.
+
+	@param type		\[X̎.
+	@param id		OpenGL̃IuWFNgID.
+	@param bytes	VoCg.
+
+	o^ĂȂ\[X̏ꍇ͉Ȃ.
+*/
+void GpuResourceRegistry::Resize(GpuResourceType type, GLuint id, size_t bytes)
+{
+	const auto itr = entries.find(Key(type, id));
+	if (itr == entries.end()) {
+		return;
+	}
+	Entry& e = itr->second;
+	const bool wasOverOwner = IsOverBudget(e.owner);
+	const bool wasOverTotal = IsOverBudget();
+	SubtractBytes(e.owner, e.bytes);
+	typeBytes[static_cast<int>(type)] -= e.bytes;
+	e.bytes = bytes;
+	AddBytes(e.owner, e.bytes);
+	typeBytes[static_cast<int>(type)] += e.bytes;
+
+	if (!wasOverOwner && IsOverBudget(e.owner)) {
+		std::cerr << "[x]" << __func__ << ": " << OwnerName(e.owner) <<
+			"GPU\Z𒴂܂(" << OwnerBytes(e.owner) << "/" <<
+			Budget(e.owner) << "oCg).\n";
+	}
+	if (!wasOverTotal && IsOverBudget()) {
+		std::cerr << "[x]" << __func__ << ": GPU̍v\Z𒴂܂(" <<
+			totalBytes << "/" << totalBudget << "oCg).\n";
+	}
+}
+
+/*
+	\[X̓o^.
+
+	@param type	\[X̎.
+	@param id	OpenGL̃IuWFNgID.
+
+	o^ĂȂ\[X̏ꍇ͉Ȃ.
+*/
+void GpuResourceRegistry::Unregister(GpuResourceType type, GLuint id)
+{
+	const auto itr = entries.find(Key(type, id));
+	if (itr == entries.end()) {
+		return;
+	}
+	SubtractBytes(itr->second.owner, itr->second.bytes);
+	typeBytes[static_cast<int>(type)] -= itr->second.bytes;
+	entries.erase(itr);
+}
+
+/*
+	ʂ̃\[X̏L҂ƍ쐬ʒup.
+
+	@param type	\[X̎.
+	@param id	p\[XID.
+	@param from	p̃\[XID.
+
+	蒼Ēu郊\[XÃ\[XƓL҂ƂĐ悤ɂ.
+*/
+void GpuResourceRegistry::Inherit(GpuResourceType type, GLuint id, GLuint from)
+{
+	const auto src = entries.find(Key(type, from));
+	const auto dst = entries.find(Key(type, id));
+	if (src == entries.end() || dst == entries.end() || src == dst) {
+		return;
+	}
+	const size_t bytes = dst->second.bytes;
+	SubtractBytes(dst->second.owner, bytes);
+	dst->second.owner = src->second.owner;
+	dst->second.site = src->second.site;
+	AddBytes(dst->second.owner, bytes);
+}
+
+/*
+	L҂̃oCg擾.
+
+	@param owner	LҖ.
+
+	@return L҂\[X̍voCg.
+*/
+size_t GpuResourceRegistry::OwnerBytes(const std::string& owner) const
+{
+	const auto itr = ownerBytes.find(owner);
+	return itr != ownerBytes.end() ? itr->second : 0;
+}
+
+/*
+	L҂̃\[X擾.
+
+	@param owner	LҖ.
+
+	@return L҂\[X̐.
+*/
+size_t GpuResourceRegistry::OwnerCount(const std::string& owner) const
+{
+	size_t count = 0;
+	for (const auto& e : entries) {
+		if (e.second.owner == owner) {
+			++count;
+		}
+	}
+	return count;
+}
+
+/*
+	L҂̗\Zݒ肷.
+
+	@param owner	LҖ.
+	@param bytes	\Z̃oCg. 0Ȃ疳.
+*/
+void GpuResourceRegistry::Budget(const std::string& owner, size_t bytes)
+{
+	if (bytes) {
+		budgets[owner] = bytes;
+	} else {
+		budgets.erase(owner);
+	}
+}
+
+/*
+	L҂̗\Z擾.
+
+	@param owner	LҖ.
+
+	@return \Z̃oCg. 0Ȃ疳.
+*/
+size_t GpuResourceRegistry::Budget(const std::string& owner) const
+{
+	const auto itr = budgets.find(owner);
+	return itr != budgets.end() ? itr->second : 0;
+}
+
+/*
+	Ŝ̗\Z𒴂Ă邩ׂ.
+
+	@retval true	Ă.
+	@retval false	ĂȂA܂͖.
+*/
+bool GpuResourceRegistry::IsOverBudget() const
+{
+	return totalBudget && totalBytes > totalBudget;
+}
+
+/*
+	L҂̗\Z𒴂Ă邩ׂ.
+
+	@param owner	LҖ.
+
+	@retval true	Ă.
+	@retval false	ĂȂA܂͖.
+*/
+bool GpuResourceRegistry::IsOverBudget(const std::string& owner) const
+{
+	const size_t budget = Budget(owner);
+	return budget && OwnerBytes(owner) > budget;
+}
+
+/*
+	L҂ɎcĂ郊\[Xo͂.
+
+	@param owner	LҖ.
+	@param os		o͐.
+
+	@return cĂ郊\[X̐.
+
+	V[̔jɌĂяoƁAYꂽ\[X.
+*/
+size_t GpuResourceRegistry::ReportLeaks(const std::string& owner, std::ostream& os) const
+{
+	std::vector<const Entry*> leaks;
+	for (const auto& e : entries) {
+		if (e.second.owner == owner) {
+			leaks.push_back(&e.second);
+		}
+	}
+	if (leaks.empty()) {
+		return 0;
+	}
+	std::sort(leaks.begin(), leaks.end(), [](const Entry* a, const Entry* b) {
+		return a->bytes > b->bytes;
+	});
+	os << "[x]" << __func__ << ": " << OwnerName(owner) << "GPU\[X" <<
+		leaks.size() << "(" << OwnerBytes(owner) << "oCg)Ă܂.\n";
+	for (const Entry* e : leaks) {
+		os << "  " << TypeName(e->type) << " " << e->id << ": " << e->bytes << "oCg ";
+		if (e->site.file) {
+			os << e->site.file << "(" << e->site.line << ") ";
+		}
+		os << e->site.function << "\n";
+	}
+	return leaks.size();
+}
+
+/*
+	L҂Ƃ̎gpʂo͂.
+
+	@param os	o͐.
+*/
+void GpuResourceRegistry::Report(std::ostream& os) const
+{
+	std::vector<std::pair<std::string, size_t>> owners(ownerBytes.begin(), ownerBytes.end());
+	std::sort(owners.begin(), owners.end(),
+		[](const std::pair<std::string, size_t>& a, const std::pair<std::string, size_t>& b) {
+			return a.second > b.second;
+		});
+	os << "[]" << __func__ << ": GPUv " << totalBytes << "oCg";
+	if (totalBudget) {
+		os << " (\Z " << totalBudget << "oCg)";
+	}
+	os << "\n";
+	for (int i = 0; i < static_cast<int>(GpuResourceType::Count); ++i) {
+		os << "  " << TypeName(static_cast<GpuResourceType>(i)) << ": " << typeBytes[i] << "oCg\n";
+	}
+	for (const auto& e : owners) {
+		os << "  " << OwnerName(e.first) << ": " << e.second << "oCg";
+		const size_t budget = Budget(e.first);
+		if (budget) {
+			os << " (\Z " << budget << "oCg)";
+		}
+		os << "\n";
+	}
+}
+
+/*
+	L҂̃oCg𑝂₷.
+
+	@param owner	LҖ.
+	@param bytes	₷oCg.
+*/
+void GpuResourceRegistry::AddBytes(const std::string& owner, size_t bytes)
+{
+	if (!bytes) {
+		return;
+	}
+	ownerBytes[owner] += bytes;
+	totalBytes += bytes;
+}
+
+/*
+	L҂̃oCg炷.
+
+	@param owner	LҖ.
+	@param bytes	炷oCg.
+
+	oCg0ɂȂL҂͈ꗗ菜.
+*/
+void GpuResourceRegistry::SubtractBytes(const std::string& owner, size_t bytes)
+{
+	const auto itr = ownerBytes.find(owner);
+	if (itr == ownerBytes.end()) {
+		return;
+	}
+	itr->second -= bytes;
+	totalBytes -= bytes;
+	if (!itr->second) {
+		ownerBytes.erase(itr);
+	}
+}
+
+/*
+	RXgN^.
+
+	@param owner	ubN̊Ԃɍ쐬\[X̏LҖ.
+*/
+GpuResourceRegistry::OwnerScope::OwnerScope(const std::string& owner) :
+	prevOwner(GpuResourceRegistry::Instance().owner)
+{
+	GpuResourceRegistry::Instance().owner = owner;
+}
+
+/*
+	fXgN^.
+*/
+GpuResourceRegistry::OwnerScope::~OwnerScope()
+{
+	GpuResourceRegistry::Instance().owner.swap(prevOwner);
+}
+
+/*
+	RXgN^.
+
+	@param site	ubN̊Ԃɍ쐬\[X̍쐬ʒu.
+*/
+GpuResourceRegistry::SiteScope::SiteScope(const GpuResourceSite& site) :
+	site(site), prevSite(GpuResourceRegistry::Instance().site)
+{
+	GpuResourceRegistry::Instance().site = &this->site;
+}
+
+/*
+	fXgN^.
+*/
+GpuResourceRegistry::SiteScope::~SiteScope()
+{
+	GpuResourceRegistry::Instance().site = prevSite;
+}
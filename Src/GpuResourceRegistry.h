@@ -0,0 +1,142 @@
+/*
+	@file GpuResourceRegistry.h
+*/
+#ifndef GPURESOURCEREGISTRY_H_INCLUDED
+#define GPURESOURCEREGISTRY_H_INCLUDED
+#include <GL/glew.h>
+#include <string>
+#include <unordered_map>
+#include <iosfwd>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+	GPU\[X̎.
+*/
+enum class GpuResourceType : uint8_t
+{
+	Buffer,			///< obt@EIuWFNg.
+	VertexArray,	///< VAO.
+	Texture,		///< eNX`.
+	Program,		///< vOEIuWFNg.
+	Count,			///< ނ̐.
+};
+
+/*
+	GPU\[X쐬\[XR[ḧʒu.
+*/
+struct GpuResourceSite
+{
+	const char* file = nullptr;		///< t@C.
+	int line = 0;					///< sԍ.
+	const char* function = nullptr;	///< ֐.
+};
+
+/*
+	̍s܂ރubNō쐬GPU\[X̍쐬ʒuA̍sɂ.
+
+	OpenGL̃IuWFNg쐬֐ĂяoŎg.
+	ubNqɂȂĂꍇ́Ał̈ʒug.
+*/
+#define GPU_RESOURCE_SITE() \
+	GpuResourceRegistry::SiteScope gpuResourceSite_({ __FILE__, __LINE__, __func__ })
+
+/*
+	GPU\[X̎gpʂL^NX.
+
+	obt@AVAOAeNX`AvO쐬ƂɁAoCgALҁA쐬ʒuo^.
+	L҂͍쐬_OwnerScope̖OŁASceneStack̓V[̊֐ĂԊԃV[ݒ肷.
+	L҂Ƃ̍vƗ\Z̊mFAV[̔jɎcĂ郊\[X̕񍐂ł.
+
+	OpenGL̃IuWFNgƓACXbh炾g.
+*/
+class GpuResourceRegistry
+{
+public:
+	static GpuResourceRegistry& Instance();
+
+	void Register(GpuResourceType, GLuint id, size_t bytes, const char* function);
+	void Resize(GpuResourceType, GLuint id, size_t bytes);
+	void Unregister(GpuResourceType, GLuint id);
+	void Inherit(GpuResourceType, GLuint id, GLuint from);
+
+	size_t TotalBytes() const { return totalBytes; }
+	size_t TotalBytes(GpuResourceType type) const { return typeBytes[static_cast<int>(type)]; }
+	size_t OwnerBytes(const std::string& owner) const;
+	size_t OwnerCount(const std::string& owner) const;
+
+	// \Z̐ݒE擾(0Ȃ疳).
+	void Budget(size_t bytes) { totalBudget = bytes; }
+	size_t Budget() const { return totalBudget; }
+	void Budget(const std::string& owner, size_t bytes);
+	size_t Budget(const std::string& owner) const;
+	bool IsOverBudget() const;
+	bool IsOverBudget(const std::string& owner) const;
+
+	size_t ReportLeaks(const std::string& owner, std::ostream&) const;
+	void Report(std::ostream&) const;
+
+	/*
+		ubN̊ԁA쐬\[X̏L҂ύXNX.
+	*/
+	class OwnerScope
+	{
+	public:
+		explicit OwnerScope(const std::string& owner);
+		~OwnerScope();
+		OwnerScope(const OwnerScope&) = delete;
+		OwnerScope& operator=(const OwnerScope&) = delete;
+
+	private:
+		std::string prevOwner;	///< ɖ߂L.
+	};
+
+	/*
+		ubN̊ԁA쐬\[X̍쐬ʒuύXNX.
+
+		ڎg킸GPU_RESOURCE_SITE()}Ng.
+	*/
+	class SiteScope
+	{
+	public:
+		explicit SiteScope(const GpuResourceSite& site);
+		~SiteScope();
+		SiteScope(const SiteScope&) = delete;
+		SiteScope& operator=(const SiteScope&) = delete;
+
+	private:
+		GpuResourceSite site;			///< ̃ubN̍쐬ʒu.
+		const GpuResourceSite* prevSite;	///< ɖ߂쐬ʒu.
+	};
+
+private:
+	GpuResourceRegistry() = default;
+	~GpuResourceRegistry() = default;
+	GpuResourceRegistry(const GpuResourceRegistry&) = delete;
+	GpuResourceRegistry& operator=(const GpuResourceRegistry&) = delete;
+
+	static uint64_t Key(GpuResourceType type, GLuint id) {
+		return (static_cast<uint64_t>(type) << 32) | id;
+	}
+	void AddBytes(const std::string& owner, size_t bytes);
+	void SubtractBytes(const std::string& owner, size_t bytes);
+
+	struct Entry {
+		GpuResourceType type;
+		GLuint id;
+		size_t bytes;
+		std::string owner;		///< 쐬̏L.
+		GpuResourceSite site;	///< 쐬ʒu. filenullptrȂfunctionL.
+	};
+	std::unordered_map<uint64_t, Entry> entries;
+	std::unordered_map<std::string, size_t> ownerBytes;	///< L҂Ƃ̃oCg.
+	std::unordered_map<std::string, size_t> budgets;	///< L҂Ƃ̗\Z.
+	size_t typeBytes[static_cast<int>(GpuResourceType::Count)] = {};
+	size_t totalBytes = 0;
+	size_t totalBudget = 0;	///< Ŝ̗\Z.
+
+	std::string owner;							///< ݂̏L.
+	const GpuResourceSite* site = nullptr;		///< ݂̍쐬ʒu.
+};
+
+#endif // GPURESOURCEREGISTRY_H_INCLUDED
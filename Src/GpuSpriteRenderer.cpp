@@ -0,0 +1,288 @@
+/*
+	@file GpuSpriteRenderer.cpp
+*/
+#include "GpuSpriteRenderer.h"
+#include "SpriteBatch.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <iostream>
+
+/*
+	fXgN^.
+*/
+GpuSpriteRenderer::~GpuSpriteRenderer()
+{
+	GpuResourceRegistry& registry = GpuResourceRegistry::Instance();
+	registry.Unregister(GpuResourceType::Program, cullProgram);
+	registry.Unregister(GpuResourceType::Program, scanProgram);
+	registry.Unregister(GpuResourceType::Program, scatterProgram);
+	glDeleteProgram(cullProgram);
+	glDeleteProgram(scanProgram);
+	glDeleteProgram(scatterProgram);
+}
+
+/*
+	`ɕKvȃobt@ƃVF[_[쐬.
+
+	@param maxSpriteCount	`\ȍőXvCg.
+	@param textureArray		XvCg̃eNX`i[zeNX`.
+
+	@retval true	.
+	@retval false	s.
+*/
+bool GpuSpriteRenderer::Init(size_t maxSpriteCount, const Texture::ImageArray2DPtr& textureArray)
+{
+	GPU_RESOURCE_SITE();
+	this->maxSpriteCount = maxSpriteCount;
+	this->textureArray = textureArray;
+
+	const size_t groupCount = (maxSpriteCount + groupSize - 1) / groupSize;
+	instanceBuffer.Create(GL_SHADER_STORAGE_BUFFER,
+		maxSpriteCount * sizeof(Instance), nullptr, GL_DYNAMIC_DRAW);
+	visibleBuffer.Create(GL_SHADER_STORAGE_BUFFER,
+		maxSpriteCount * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+	localOffsetBuffer.Create(GL_SHADER_STORAGE_BUFFER,
+		maxSpriteCount * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+	groupBuffer.Create(GL_SHADER_STORAGE_BUFFER,
+		groupCount * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+	indirectBuffer.Create(GL_DRAW_INDIRECT_BUFFER, 4 * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+	vao.Create(0, 0);
+
+	cullProgram = Shader::BuildComputeFromFile("Res/SpriteCull.comp", "#define PASS_CULL\n");
+	scanProgram = Shader::BuildComputeFromFile("Res/SpriteCull.comp", "#define PASS_SCAN\n");
+	scatterProgram = Shader::BuildComputeFromFile("Res/SpriteCull.comp", "#define PASS_SCATTER\n");
+
+	Shader::Permutation permutation;
+	permutation.features = Shader::Feature_Textured | Shader::Feature_TextureArray;
+	drawProgram = Shader::ProgramCache::Instance().Get(
+		"Res/SpriteInstance.vert", "Res/Sprite.frag", permutation);
+
+	// t[ݒ肷郆jtH[ϐ̈ʒúAŒׂĂ.
+	cullSpriteCountLocation = glGetUniformLocation(cullProgram, "spriteCount");
+	cullViewRectLocation = glGetUniformLocation(cullProgram, "viewRect");
+	scanGroupCountLocation = glGetUniformLocation(scanProgram, "groupCount");
+	scatterSpriteCountLocation = glGetUniformLocation(scatterProgram, "spriteCount");
+
+	instances.reserve(maxSpriteCount);
+
+	// ߒ̂ǂꂩ̃IuWFNg̍쐬ɎsĂÅ֐̂sƂ.
+	if (!instanceBuffer.Id() || !visibleBuffer.Id() || !localOffsetBuffer.Id() ||
+		!groupBuffer.Id() || !indirectBuffer.Id() || !vao.Id() ||
+		!cullProgram || !scanProgram || !scatterProgram || !drawProgram->Id()) {
+		std::cerr << "[G[]" << __func__ << ": Ɏs.\n";
+		return false;
+	}
+	return true;
+}
+
+/*
+	XvCg1̃CX^X쐬.
+
+	@param i		ob`̃XvCg̓Y.
+	@param batch	XvCgob`.
+*/
+void GpuSpriteRenderer::MakeInstance(size_t i, const SpriteBatch& batch)
+{
+	const Texture::Image2DPtr& texture = batch.GetTexture(batch.TextureIndices()[i]);
+	const int layer = texture ? textureArray->FindLayer(texture.get()) : -1;
+	const Rect& rect = batch.Rects()[i];
+	const glm::vec2 reciprocalSize =
+		glm::vec2(1) / glm::vec2(textureArray->Width(), textureArray->Height());
+
+	Instance& e = instances[i];
+	e.positionAndRotation = glm::vec4(batch.Positions()[i], batch.Rotations()[i]);
+	e.color = PremultipliedColor(batch.Colors()[i], batch.BlendModes()[i]);
+	e.texRect = glm::vec4(rect.origin * reciprocalSize, rect.size * reciprocalSize);
+	e.halfSizeAndLayer = glm::vec4(rect.size * 0.5f * batch.Scales()[i],
+		static_cast<float>(layer), 0);
+}
+
+/*
+	ύXꂽXvCg̃CX^X].
+
+	@param batch	CX^X̌ƂȂXvCgob`.
+
+	@retval true	XV.
+	@retval false	őXvCg𒴂ĂāAꕔ̃XvCg\łȂ.
+
+	SpriteRenderer::UpdateVertices()ƓlɁAύXꂽXvCg]A
+	߂ɂύXӏ͂܂Ƃ߂1œ].
+*/
+bool GpuSpriteRenderer::UpdateInstances(const SpriteBatch& batch)
+{
+	const size_t spriteCount = std::min(batch.Size(), maxSpriteCount);
+
+	// ʂ̃ob`ɐ؂ւAXvCg̒ǉ폜ꍇ͑Sč蒼.
+	// 폜͖Ƃ̓ւōŝŁAYĂ\.
+	const bool isRebuild = currentBatch != &batch || currentVersion != batch.StructureVersion();
+	currentBatch = &batch;
+	currentVersion = batch.StructureVersion();
+	instances.resize(spriteCount);
+
+	static const size_t mergeDistance = 8;	// ̐ȉ̊ԊuȂ͈͂܂Ƃ߂.
+	const std::vector<uint32_t>& changeVersions = batch.ChangeVersions();
+	size_t rangeBegin = 0;
+	size_t rangeEnd = 0;
+	const auto flush = [this, &rangeBegin, &rangeEnd]() {
+		if (rangeBegin < rangeEnd) {
+			instanceBuffer.BufferSubData(rangeBegin * sizeof(Instance),
+				(rangeEnd - rangeBegin) * sizeof(Instance), &instances[rangeBegin]);
+		}
+	};
+	for (size_t i = 0; i < spriteCount; ++i) {
+		if (!isRebuild && changeVersions[i] <= currentChangeVersion) {
+			continue;
+		}
+		MakeInstance(i, batch);
+		if (rangeBegin < rangeEnd && i - rangeEnd <= mergeDistance) {
+			rangeEnd = i + 1;
+		} else {
+			flush();
+			rangeBegin = i;
+			rangeEnd = i + 1;
+		}
+	}
+	flush();
+	currentChangeVersion = batch.ChangeVersion();
+
+	if (batch.Size() > maxSpriteCount) {
+		std::cerr << "[x]" << __func__ << ": ő\𒴂Ă܂.\n";
+		return false;
+	}
+	return true;
+}
+
+/*
+	XvCg`悷.
+
+	@param camera	`ɎgpJ.
+
+	\Alߍ݁A`SGPUōs.
+*/
+void GpuSpriteRenderer::Draw(const Camera2D& camera) const
+{
+	const GLuint spriteCount = static_cast<GLuint>(instances.size());
+	if (spriteCount == 0) {
+		return;
+	}
+	const GLuint groupCount = (spriteCount + groupSize - 1) / groupSize;
+	const Rect& view = camera.VisibleRect();
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instanceBuffer.Id());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visibleBuffer.Id());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, localOffsetBuffer.Id());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, groupBuffer.Id());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, indirectBuffer.Id());
+
+	// \ƃ[NO[v̗ݐϘa.
+	glUseProgram(cullProgram);
+	glUniform1ui(cullSpriteCountLocation, spriteCount);
+	glUniform4f(cullViewRectLocation, view.origin.x, view.origin.y,
+		view.origin.x + view.size.x, view.origin.y + view.size.y);
+	glDispatchCompute(groupCount, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	// [NO[vԂ̗ݐϘaƕ`搔.
+	glUseProgram(scanProgram);
+	glUniform1ui(scanGroupCountLocation, groupCount);
+	glDispatchCompute(1, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+	// \CX^X̔ԍl߂.
+	glUseProgram(scatterProgram);
+	glUniform1ui(scatterSpriteCountLocation, spriteCount);
+	glDispatchCompute(groupCount, 1, 1);
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+	// GPU񂾕`R}hŕ`悷.
+	// `pX͕Ȃ̂ŁAsȃXvCg̓At@1̔Ƃč.
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	camera.ApplyViewport();
+	vao.Bind();
+	drawProgram->Use();
+	drawProgram->SetViewProjectionMatrix(camera.ViewProjectionMatrix());
+	drawProgram->BindTexture(0, textureArray->Get(), GL_TEXTURE_2D_ARRAY);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer.Id());
+	glDrawArraysIndirect(GL_TRIANGLES, nullptr);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	drawProgram->BindTexture(0, 0, GL_TEXTURE_2D_ARRAY);
+	vao.Unbind();
+
+	for (GLuint i = 0; i <= 4; ++i) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, 0);
+	}
+}
+
+/*
+	GPUƓ\CPUōs.
+
+	@param instances		肷CX^X.
+	@param view				\͈.
+	@param visibleIndices	\CX^X̔ԍȀԂŊi[z.
+
+	@return \CX^X̐.
+
+	SpriteCull.comp3̃pX킹ʂƓɂȂ.
+	OpenGL̊֐gȂ̂ŁAGPUȂĂʂm߂.
+*/
+size_t GpuSpriteRenderer::CullReference(const std::vector<Instance>& instances,
+	const Rect& view, std::vector<GLuint>& visibleIndices)
+{
+	visibleIndices.clear();
+	const glm::vec4 viewRect(view.origin, view.origin + view.size);
+	for (size_t i = 0; i < instances.size(); ++i) {
+		const Instance& e = instances[i];
+		const float r = glm::length(glm::vec2(e.halfSizeAndLayer.x, e.halfSizeAndLayer.y));
+		const glm::vec2 p(e.positionAndRotation.x, e.positionAndRotation.y);
+		if (e.halfSizeAndLayer.z >= 0 &&
+			p.x + r >= viewRect.x && p.x - r <= viewRect.z &&
+			p.y + r >= viewRect.y && p.y - r <= viewRect.w) {
+			visibleIndices.push_back(static_cast<GLuint>(i));
+		}
+	}
+	return visibleIndices.size();
+}
+
+/*
+	GPU̕\̌ʂCPǓʂƔr.
+
+	@param camera	ODraw()ɎgpJ.
+
+	@retval true	ʂv.
+	@retval false	ʂقȂ. ႢWG[o͂ɏo.
+
+	GPȔI܂ő҂̂ŁAmFprȊOł͌ĂяoȂ.
+	\͈͂̋Eɂ傤ǐڂXvCǵAZ덷ŌʂقȂꍇ.
+*/
+bool GpuSpriteRenderer::Verify(const Camera2D& camera) const
+{
+	std::vector<GLuint> expected;
+	CullReference(instances, camera.VisibleRect(), expected);
+
+	GLuint command[4] = {};
+	glBindBuffer(GL_COPY_READ_BUFFER, indirectBuffer.Id());
+	glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(command), command);
+	const GLuint visibleCount = instances.empty() ? 0 : command[1];
+	std::vector<GLuint> actual(std::min<size_t>(visibleCount, maxSpriteCount));
+	if (!actual.empty()) {
+		glBindBuffer(GL_COPY_READ_BUFFER, visibleBuffer.Id());
+		glGetBufferSubData(GL_COPY_READ_BUFFER, 0, actual.size() * sizeof(GLuint), actual.data());
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+	if (visibleCount != expected.size()) {
+		std::cerr << "[G[]" << __func__ << ": \v܂(GPU=" << visibleCount <<
+			", CPU=" << expected.size() << ").\n";
+		return false;
+	}
+	const auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+	if (mismatch.first != expected.end()) {
+		std::cerr << "[G[]" << __func__ << ": " << (mismatch.first - expected.begin()) <<
+			"Ԗڂ̕\CX^Xv܂(GPU=" << *mismatch.second <<
+			", CPU=" << *mismatch.first << ").\n";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,85 @@
+/*
+	@file GpuSpriteRenderer.h
+*/
+#ifndef GPUSPRITERENDERER_H_INCLUDED
+#define GPUSPRITERENDERER_H_INCLUDED
+#include "BufferObject.h"
+#include "Texture.h"
+#include "Shader.h"
+#include "Camera2D.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+class SpriteBatch;
+
+/*
+	\GPUōsXvCg`NX.
+
+	XvCgCX^XEobt@ɕێARs[gVF[_[
+	J̕\͈͂ƏdȂ̂IŁȀԂ̂܂܋l߂.
+	`搔GPU`R}hɒڏނ̂ŁACPU͌ʂ҂Ȃ.
+
+	eNX`͔zeNX`Ɋi[ĂKv.
+	i[ĂȂeNX`gXvCg͕`悳Ȃ.
+
+	CullReference()GPUƓ\CPUōs. Verify()GPǓʂƔrł.
+*/
+class GpuSpriteRenderer
+{
+public:
+	GpuSpriteRenderer() = default;
+	~GpuSpriteRenderer();
+	GpuSpriteRenderer(const GpuSpriteRenderer&) = delete;
+	GpuSpriteRenderer& operator=(const GpuSpriteRenderer&) = delete;
+
+	// VF[_[Instance\̂Ɠ.
+	struct Instance {
+		glm::vec4 positionAndRotation;	///< xyz=S̍W, w=]px.
+		glm::vec4 color;				///< F.
+		glm::vec4 texRect;				///< eNX`W̌_Ƒ傫.
+		glm::vec4 halfSizeAndLayer;		///< S̑傫Ƒwԍ(Ȃ`悵Ȃ).
+	};
+
+	bool Init(size_t maxSpriteCount, const Texture::ImageArray2DPtr& textureArray);
+	bool UpdateInstances(const SpriteBatch&);
+	void Draw(const Camera2D&) const;
+	bool Verify(const Camera2D&) const;
+	const std::vector<Instance>& Instances() const { return instances; }
+
+	static size_t CullReference(const std::vector<Instance>&, const Rect& view,
+		std::vector<GLuint>& visibleIndices);
+
+private:
+	void MakeInstance(size_t i, const SpriteBatch&);
+
+	static const GLuint groupSize = 256;	///< Rs[gVF[_[̃[NO[v̑傫.
+
+	size_t maxSpriteCount = 0;
+	Texture::ImageArray2DPtr textureArray;
+	BufferObject instanceBuffer;	///< SẴCX^X.
+	BufferObject visibleBuffer;		///< \CX^X̔ԍ.
+	BufferObject localOffsetBuffer;	///< [NO[v݈̏ʒu.
+	BufferObject groupBuffer;		///< [NO[vƂ̕\Ə݈ʒu.
+	BufferObject indirectBuffer;	///< GPUޕ`R}h.
+	VertexArrayObject vao;			///< _f[^gȂ̂ŋ.
+
+	GLuint cullProgram = 0;			///< \.
+	GLuint scanProgram = 0;			///< [NO[vԂ̗ݐϘa.
+	GLuint scatterProgram = 0;		///< \CX^X̋lߍ.
+	Shader::ProgramPtr drawProgram;
+
+	// Rs[gVF[_[̃jtH[ϐ̈ʒu.
+	GLint cullSpriteCountLocation = -1;
+	GLint cullViewRectLocation = -1;
+	GLint scanGroupCountLocation = -1;
+	GLint scatterSpriteCountLocation = -1;
+
+	// ێĂXvCg̏.
+	std::vector<Instance> instances;		///< CX^XEobt@Ɠe.
+	const SpriteBatch* currentBatch = nullptr;	///< ŌUpdateInstances()ob`.
+	uint32_t currentVersion = 0;			///< Ōɔfob`̍\ԍ.
+	uint32_t currentChangeVersion = 0;		///< Ōɔfob`̕ύXԍ.
+};
+
+#endif // GPUSPRITERENDERER_H_INCLUDED
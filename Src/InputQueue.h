@@ -0,0 +1,93 @@
+/*
+	@file InputQueue.h
+*/
+#ifndef INPUTQUEUE_H_INCLUDED
+#define INPUTQUEUE_H_INCLUDED
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+	̓Cxg.
+*/
+struct InputEvent
+{
+	// Cxg̎.
+	enum Type : uint8_t {
+		Key,			///< L[{[h̃L[.
+		JoystickButton,	///< Q[pbh̃{^.
+		JoystickAxis,	///< Q[pbh̃AiO.
+		JoystickConnection,	///< Q[pbh̐ڑ(value = 1Őڑ).
+	};
+
+	Type type;		///< Cxg̎.
+	int code;		///< L[R[hA{^ԍA܂͎ԍ.
+	float value;	///< GLFW_PRESS/GLFW_RELEASEA܂͎̒l.
+	double time;	///< Cxg(b).
+};
+
+/*
+	̓Cxg󂯓n߂̃bNt[EL[.
+
+	Push()ĂԃXbhPop()ĂԃXbhꂼ1̏ꍇɌA
+	bNȂŃXbhԂ̎󂯓nł.
+*/
+class InputQueue
+{
+public:
+	static const size_t capacity = 256;	///< i[łCxg̍ő吔(2ׂ̂).
+
+	InputQueue() = default;
+	InputQueue(const InputQueue&) = delete;
+	InputQueue& operator=(const InputQueue&) = delete;
+
+	/*
+		Cxgǉ.
+
+		@param e	ǉCxg.
+
+		@retval true	ǉ.
+		@retval false	L[tŒǉłȂ.
+	*/
+	bool Push(const InputEvent& e)
+	{
+		const size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) >= capacity) {
+			++droppedCount;
+			return false;
+		}
+		buffer[t & (capacity - 1)] = e;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+		Cxgo.
+
+		@param e	oCxgi[ϐ.
+
+		@retval true	o.
+		@retval false	L[.
+	*/
+	bool Pop(InputEvent& e)
+	{
+		const size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		e = buffer[h & (capacity - 1)];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	// L[tŎ̂ĂꂽCxg̐.
+	size_t DroppedCount() const { return droppedCount; }
+
+private:
+	InputEvent buffer[capacity];
+	std::atomic<size_t> head = { 0 };	///< Ɏoʒu().
+	std::atomic<size_t> tail = { 0 };	///< ɒǉʒu().
+	size_t droppedCount = 0;			///< .
+};
+
+#endif // INPUTQUEUE_H_INCLUDED
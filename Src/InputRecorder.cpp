@@ -0,0 +1,181 @@
+/*
+	@file InputRecorder.cpp
+*/
+#include "InputRecorder.h"
+#include <algorithm>
+#include <iostream>
+
+namespace /* unnamed */ {
+
+// L^t@C̎ʎqƃo[W.
+// o[W2ŌoߎԂfloatdoubleɕύX.
+// o[W3ō\̂̋lߕ܂Ȃ悤ɁAvfƂɏނ悤ɂ.
+const char fileMagic[4] = { 'I', 'R', 'E', 'C' };
+const uint32_t fileVersion = 3;
+
+// 1t[̋L^̃oCg.
+const size_t recordSize = sizeof(uint16_t) * 2 + sizeof(double);
+
+} // unnamed namespace
+
+/*
+	L^Jn.
+
+	@param path	L^̃t@C.
+
+	@retval true	Jn.
+	@retval false	t@C쐬łȂ.
+*/
+bool InputRecorder::Begin(const char* path)
+{
+	End();
+	ofs.open(path, std::ios_base::binary);
+	if (!ofs.is_open()) {
+		std::cerr << "[G[]" << __func__ << ": " << path << " 쐬ł܂.\n";
+		return false;
+	}
+	ofs.write(fileMagic, sizeof(fileMagic));
+	ofs.write(reinterpret_cast<const char*>(&fileVersion), sizeof(fileVersion));
+	frameCount = 0;
+	std::cout << "[͋L^] Jn: " << path << "\n";
+	return true;
+}
+
+/*
+	1t[̓͂L^.
+
+	@param gamepad		L^Q[pbh̏.
+	@param deltaTime	Õt[̌oߎ(b).
+*/
+void InputRecorder::Record(const GamePad& gamepad, double deltaTime)
+{
+	if (!ofs.is_open()) {
+		return;
+	}
+	const uint16_t buttons = static_cast<uint16_t>(gamepad.buttons);
+	const uint16_t buttonDown = static_cast<uint16_t>(gamepad.buttonDown);
+	ofs.write(reinterpret_cast<const char*>(&buttons), sizeof(buttons));
+	ofs.write(reinterpret_cast<const char*>(&buttonDown), sizeof(buttonDown));
+	ofs.write(reinterpret_cast<const char*>(&deltaTime), sizeof(deltaTime));
+	++frameCount;
+}
+
+/*
+	L^I.
+*/
+void InputRecorder::End()
+{
+	if (ofs.is_open()) {
+		ofs.close();
+		std::cout << "[͋L^] I: " << frameCount << "t[\n";
+	}
+}
+
+/*
+	L^t@CǂݍōĐJn.
+
+	@param path	L^t@C.
+
+	@retval true	ǂݍݐ.
+	@retval false	ǂݍݎs.
+*/
+bool InputReplayer::Load(const char* path)
+{
+	std::ifstream ifs(path, std::ios_base::binary);
+	if (!ifs.is_open()) {
+		std::cerr << "[G[]" << __func__ << ": " << path << " J܂.\n";
+		return false;
+	}
+	char magic[4];
+	uint32_t version = 0;
+	ifs.read(magic, sizeof(magic));
+	ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+	if (!ifs || !std::equal(magic, magic + 4, fileMagic) || version != fileVersion) {
+		std::cerr << "[G[]" << __func__ << ": " << path << " ͓͋L^t@Cł͂܂.\n";
+		return false;
+	}
+
+	// cׂ͂ăt[Ƃ̋L^.
+	const std::streampos begin = ifs.tellg();
+	ifs.seekg(0, std::ios_base::end);
+	const size_t frames = static_cast<size_t>(ifs.tellg() - begin) / recordSize;
+	ifs.seekg(begin);
+	records.resize(frames);
+	for (InputRecord& e : records) {
+		ifs.read(reinterpret_cast<char*>(&e.buttons), sizeof(e.buttons));
+		ifs.read(reinterpret_cast<char*>(&e.buttonDown), sizeof(e.buttonDown));
+		ifs.read(reinterpret_cast<char*>(&e.deltaTime), sizeof(e.deltaTime));
+	}
+
+	frameTimes.clear();
+	frameTimes.reserve(frames);
+	position = 0;
+	isPlaying = true;
+	std::cout << "[͍Đ] Jn: " << path << " (" << frames << "t[)\n";
+	return true;
+}
+
+/*
+	̃t[̓͂擾.
+
+	@param gamepad		͂i[Q[pbh.
+	@param deltaTime	oߎԂi[ϐ.
+
+	@retval true	擾.
+	@retval false	L^̏I[ɒB. Đ͏I.
+*/
+bool InputReplayer::Next(GamePad& gamepad, double& deltaTime)
+{
+	if (position >= records.size()) {
+		if (isPlaying) {
+			isPlaying = false;
+			std::cout << "[͍Đ] I\n";
+			PrintStatistics();
+		}
+		return false;
+	}
+	const InputRecord& record = records[position++];
+	gamepad.buttons = record.buttons;
+	gamepad.buttonDown = record.buttonDown;
+	deltaTime = record.deltaTime;
+	return true;
+}
+
+/*
+	ĐɌvۂ̃t[Ԃǉ.
+
+	@param frameTime	t[(b).
+*/
+void InputReplayer::AddFrameTime(double frameTime)
+{
+	frameTimes.push_back(frameTime);
+}
+
+/*
+	Đ̃t[Ԃ̓vR\[ɏo͂.
+
+	قȂrhœL^ĐA̒lr邱ƂŐ\̕ω킩.
+*/
+void InputReplayer::PrintStatistics() const
+{
+	// ŏ̃t[͏܂ނ̂ŏO.
+	if (frameTimes.size() < 2) {
+		return;
+	}
+	std::vector<double> sorted(frameTimes.begin() + 1, frameTimes.end());
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0;
+	for (double e : sorted) {
+		total += e;
+	}
+	const auto percentile = [&sorted](double p) {
+		return sorted[static_cast<size_t>(p * (sorted.size() - 1))] * 1000.0;
+	};
+	std::cout << "[͍Đ] t[(ms)"
+		<< " frames:" << sorted.size()
+		<< " avg:" << total / sorted.size() * 1000.0
+		<< " min:" << sorted.front() * 1000.0
+		<< " median:" << percentile(0.5)
+		<< " 99%:" << percentile(0.99)
+		<< " max:" << sorted.back() * 1000.0 << "\n";
+}
@@ -0,0 +1,69 @@
+/*
+	@file InputRecorder.h
+*/
+#ifndef INPUTRECORDER_H_INCLUDED
+#define INPUTRECORDER_H_INCLUDED
+#include "GamePad.h"
+#include <fstream>
+#include <vector>
+
+/*
+	1t[̋L^f[^.
+
+	t@Cɂ͋lߕ܂߂Ȃ悤ɁAvfƂɏ(2+2+8oCg).
+*/
+struct InputRecord
+{
+	uint16_t buttons;		///< GamePad::buttons.
+	uint16_t buttonDown;	///< GamePad::buttonDown.
+	double deltaTime;		///< Õt[̌oߎ(b). ŒXebv̒~ςƓxŋL^.
+};
+
+/*
+	Q[pbh̓͂ƌoߎԂt[ƂɃt@C֋L^NX.
+*/
+class InputRecorder
+{
+public:
+	InputRecorder() = default;
+	~InputRecorder() { End(); }
+	InputRecorder(const InputRecorder&) = delete;
+	InputRecorder& operator=(const InputRecorder&) = delete;
+
+	bool Begin(const char* path);
+	void Record(const GamePad&, double deltaTime);
+	void End();
+	bool IsRecording() const { return ofs.is_open(); }
+
+private:
+	std::ofstream ofs;
+	size_t frameCount = 0;
+};
+
+/*
+	L^Q[pbh̓͂ƌoߎԂĐNX.
+
+	Đ̎ۂ̃t[ԂvAĐIɓvo͂.
+*/
+class InputReplayer
+{
+public:
+	InputReplayer() = default;
+	~InputReplayer() = default;
+	InputReplayer(const InputReplayer&) = delete;
+	InputReplayer& operator=(const InputReplayer&) = delete;
+
+	bool Load(const char* path);
+	bool Next(GamePad&, double& deltaTime);
+	void AddFrameTime(double);
+	void PrintStatistics() const;
+	bool IsPlaying() const { return isPlaying; }
+
+private:
+	std::vector<InputRecord> records;
+	std::vector<double> frameTimes;	///< ĐɌvۂ̃t[.
+	size_t position = 0;
+	bool isPlaying = false;
+};
+
+#endif // INPUTRECORDER_H_INCLUDED
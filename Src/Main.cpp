@@ -1,19 +1,63 @@
 #include "TitleScene.h"
 #include "GLFWEW.h"
+#include "TextureStreamer.h"
+#include "ShaderReloader.h"
+#include <string>
 
-int main()
+/*
+	Gg[|Cg.
+
+	R}hC:
+		--record <t@C>	͂L^.
+		--replay <t@C>	L^͂EBhE\ɍōōĐA
+								t[Ԃ̓vo͂ďI.
+*/
+int main(int argc, char* argv[])
 {
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+	for (int i = 1; i + 1 < argc; ++i) {
+		const std::string arg = argv[i];
+		if (arg == "--record") {
+			recordPath = argv[++i];
+		} else if (arg == "--replay") {
+			replayPath = argv[++i];
+		}
+	}
+
 	GLFWEW::Window& window = GLFWEW::Window::Instance();
-	window.Init(1280, 720, u8"ANVQ[");
+	window.SetHidden(replayPath != nullptr);
+	if (!window.Init(1280, 720, u8"ANVQ[")) {
+		return 1;
+	}
+	if (replayPath) {
+		// ҂ɍōōĐ.
+		window.SetSwapInterval(0);
+		if (!window.StartReplay(replayPath)) {
+			return 1;
+		}
+	} else {
+		window.SetSwapInterval(-1);
+		window.SetLowLatencyMode(true);
+		if (recordPath) {
+			window.StartRecording(recordPath);
+		}
+	}
 
 	SceneStack& sceneStack = SceneStack::Instance();
 	sceneStack.Push(std::make_shared<TitleScene>());
 
+	// 60HžŒXebvōXVA1t[̒ǂ͍ő5܂.
+	window.SetFixedTimeStep(60, 5);
+	window.InitTimer();
 	while (!window.ShouldClose()) {
-		const float deltaTime = window.DeltaTime();
 		window.UpdataTimer();
-		sceneStack.Update(deltaTime);
+		while (window.NextFixedStep()) {
+			sceneStack.Update(static_cast<float>(window.DeltaTime()));
+		}
 		sceneStack.Render();
+		Texture::Streamer::Instance().Update();
+		Shader::Reloader::Instance().Update();
 		window.SwapBuffers();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+/*
+	@file Particle.cpp
+*/
+#include "Particle.h"
+#include <algorithm>
+#include <cmath>
+
+// SSE2gł́A4̃p[eBN܂Ƃ߂čXV.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+	RXgN^.
+
+	@param p				G~b^[̃p[^[.
+	@param maxParticleCount	ɑ݂łőp[eBN.
+*/
+ParticleEmitter::ParticleEmitter(const ParticleEmitterParameter& p, size_t maxParticleCount) :
+	param(p),
+	colorDelta((p.endColor - p.startColor) / std::max(p.lifetime, 0.001f)),
+	maxCount(maxParticleCount),
+	random(std::random_device()())
+{
+	const size_t n = (maxParticleCount + 3) & ~size_t(3);
+	for (std::vector<float>* e : { &posX, &posY, &velX, &velY,
+		&colorR, &colorG, &colorB, &colorA, &life }) {
+		e->resize(n, 0.0f);
+	}
+}
+
+/*
+	p[eBNoAԂXV.
+
+	@param deltaTime	O̍XV̌oߎ(b).
+	@param pool			XVɎgƃXbh. nullptrȂ炱̃XbhōXV.
+
+	oƍ폜͌ĂяoXbhōsAړƐF̕ω𕡐̃Xbhɕ.
+*/
+void ParticleEmitter::Update(float deltaTime, ThreadPool* pool)
+{
+	// 1Xbh̍ŏp[eBN. ȂƎd̎󂯓n̎Ԃ̕Ȃ.
+	static const size_t minParticlesPerThread = 4096;
+
+	const size_t threadCount = pool ? pool->WorkerCount() + 1 : 1;
+	const size_t n = std::min(threadCount, count / minParticlesPerThread);
+	if (n <= 1) {
+		Integrate(0, count, deltaTime);
+	} else {
+		// S͈͂SIMDł܂Ƃ߂čXVł悤4̔{ŋ؂.
+		const size_t chunkSize = ((count + n - 1) / n + 3) & ~size_t(3);
+		const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+		pool->Run(chunkCount, [this, chunkSize, deltaTime](size_t i) {
+			const size_t begin = i * chunkSize;
+			Integrate(begin, std::min(begin + chunkSize, count), deltaTime);
+		});
+	}
+	RemoveDead();
+
+	if (!isStopped) {
+		emissionTimer += deltaTime * param.emissionRate;
+		const size_t emitCount = static_cast<size_t>(emissionTimer);
+		emissionTimer -= static_cast<float>(emitCount);
+		Emit(emitCount);
+	}
+}
+
+/*
+	p[eBNo.
+
+	@param n	o鐔. ő吔𒴂镪͕oȂ.
+*/
+void ParticleEmitter::Emit(size_t n)
+{
+	n = std::min(n, maxCount - count);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> direction(-param.spread, param.spread);
+	std::uniform_real_distribution<float> speed(param.minSpeed, param.maxSpeed);
+	const glm::vec4 color = glm::clamp(param.startColor, glm::vec4(0), glm::vec4(1));
+	for (size_t i = count; i < count + n; ++i) {
+		// aradius̉~̒Ɉlɕz.
+		const float r = param.radius * std::sqrt(unit(random));
+		const float theta = unit(random) * 6.28318531f;
+		posX[i] = param.position.x + r * std::cos(theta);
+		posY[i] = param.position.y + r * std::sin(theta);
+
+		const float a = param.angle + direction(random);
+		const float v = speed(random);
+		velX[i] = v * std::cos(a);
+		velY[i] = v * std::sin(a);
+
+		colorR[i] = color.x;
+		colorG[i] = color.y;
+		colorB[i] = color.z;
+		colorA[i] = color.w;
+		life[i] = param.lifetime;
+	}
+	count += n;
+}
+
+/*
+	p[eBNړAFƎXV.
+
+	@param begin		XV͈͂̐擪. 4̔{ł邱.
+	@param end			XV͈͂̏I[.
+	@param deltaTime	oߎ(b).
+
+	I[4̔{ɐ؂グčXV. z4̔{̑傫Ȃ̂ŁA͈͊Oɂ͂ȂȂ.
+*/
+void ParticleEmitter::Integrate(size_t begin, size_t end, float deltaTime)
+{
+	const glm::vec2 dv = param.acceleration * deltaTime;
+	const glm::vec4 dc = colorDelta * deltaTime;
+#ifdef PARTICLE_USE_SSE2
+	const __m128 t = _mm_set1_ps(deltaTime);
+	const __m128 dvx = _mm_set1_ps(dv.x);
+	const __m128 dvy = _mm_set1_ps(dv.y);
+	const __m128 dr = _mm_set1_ps(dc.x);
+	const __m128 dg = _mm_set1_ps(dc.y);
+	const __m128 db = _mm_set1_ps(dc.z);
+	const __m128 da = _mm_set1_ps(dc.w);
+	for (size_t i = begin; i < end; i += 4) {
+		const __m128 vx = _mm_loadu_ps(&velX[i]);
+		const __m128 vy = _mm_loadu_ps(&velY[i]);
+		_mm_storeu_ps(&posX[i], _mm_add_ps(_mm_loadu_ps(&posX[i]), _mm_mul_ps(vx, t)));
+		_mm_storeu_ps(&posY[i], _mm_add_ps(_mm_loadu_ps(&posY[i]), _mm_mul_ps(vy, t)));
+		_mm_storeu_ps(&velX[i], _mm_add_ps(vx, dvx));
+		_mm_storeu_ps(&velY[i], _mm_add_ps(vy, dvy));
+		_mm_storeu_ps(&colorR[i], _mm_add_ps(_mm_loadu_ps(&colorR[i]), dr));
+		_mm_storeu_ps(&colorG[i], _mm_add_ps(_mm_loadu_ps(&colorG[i]), dg));
+		_mm_storeu_ps(&colorB[i], _mm_add_ps(_mm_loadu_ps(&colorB[i]), db));
+		_mm_storeu_ps(&colorA[i], _mm_add_ps(_mm_loadu_ps(&colorA[i]), da));
+		_mm_storeu_ps(&life[i], _mm_sub_ps(_mm_loadu_ps(&life[i]), t));
+	}
+#else
+	for (size_t i = begin; i < end; ++i) {
+		posX[i] += velX[i] * deltaTime;
+		posY[i] += velY[i] * deltaTime;
+		velX[i] += dv.x;
+		velY[i] += dv.y;
+		colorR[i] += dc.x;
+		colorG[i] += dc.y;
+		colorB[i] += dc.z;
+		colorA[i] += dc.w;
+		life[i] -= deltaTime;
+	}
+#endif
+}
+
+/*
+	sp[eBN폜.
+
+	폜ʒuɂ͖̃p[eBNړ.
+*/
+void ParticleEmitter::RemoveDead()
+{
+	for (size_t i = 0; i < count;) {
+		if (life[i] > 0) {
+			++i;
+			continue;
+		}
+		const size_t last = --count;
+		posX[i] = posX[last];
+		posY[i] = posY[last];
+		velX[i] = velX[last];
+		velY[i] = velY[last];
+		colorR[i] = colorR[last];
+		colorG[i] = colorG[last];
+		colorB[i] = colorB[last];
+		colorA[i] = colorA[last];
+		life[i] = life[last];
+	}
+}
+
+/*
+	G~b^[ǉ.
+
+	@param param			G~b^[̃p[^[.
+	@param maxParticleCount	ɑ݂łőp[eBN.
+
+	@return ǉG~b^[. Stop()ƁASẴp[eBNƂɍ폜.
+*/
+ParticleEmitterPtr ParticleSystem::Add(
+	const ParticleEmitterParameter& param, size_t maxParticleCount)
+{
+	emitters.push_back(std::make_shared<ParticleEmitter>(param, maxParticleCount));
+	return emitters.back();
+}
+
+/*
+	SẴG~b^[XV.
+
+	@param deltaTime	O̍XV̌oߎ(b).
+*/
+void ParticleSystem::Update(float deltaTime)
+{
+	for (const ParticleEmitterPtr& e : emitters) {
+		e->Update(deltaTime, &pool);
+	}
+	emitters.erase(std::remove_if(emitters.begin(), emitters.end(),
+		[](const ParticleEmitterPtr& e) { return e->IsDead(); }), emitters.end());
+}
+
+/*
+	SẴG~b^[̃p[eBN̍v擾.
+*/
+size_t ParticleSystem::ParticleCount() const
+{
+	size_t n = 0;
+	for (const ParticleEmitterPtr& e : emitters) {
+		n += e->Count();
+	}
+	return n;
+}
@@ -0,0 +1,116 @@
+/*
+	@file Particle.h
+*/
+#ifndef PARTICLE_H_INCLUDED
+#define PARTICLE_H_INCLUDED
+#include "Sprite.h"
+#include "Texture.h"
+#include "ThreadPool.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include <random>
+#include <stdint.h>
+
+/*
+	p[eBNEG~b^[̃p[^[.
+*/
+struct ParticleEmitterParameter
+{
+	Texture::Image2DPtr texture;			///< eNX`. nullptrȂFŕ`悷.
+	BlendMode blend = BlendMode::Additive;	///< @.
+	glm::vec3 position = glm::vec3(0);		///< oʒu.
+	float radius = 0;						///< o͈͂̔a.
+	float emissionRate = 100;				///< 1b̕o.
+	float lifetime = 1;						///< (b).
+	float angle = 0;						///< o(WA).
+	float spread = 3.14159265f;				///< ô΂(WA, Б).
+	float minSpeed = 50;					///< ox̍ŏl.
+	float maxSpeed = 100;					///< ox̍ől.
+	glm::vec2 acceleration = glm::vec2(0);	///< x(d͂Ȃ).
+	glm::vec4 startColor = glm::vec4(1);	///< o̐F.
+	glm::vec4 endColor = glm::vec4(1, 1, 1, 0);	///< sƂ̐F.
+	glm::vec2 size = glm::vec2(8);			///< \TCY(sNZ).
+};
+
+/*
+	p[eBNoANX.
+
+	p[eBN̗vfƂɘAzɊi[ASIMD߂4܂Ƃ߂čXV.
+	sp[eBN͖̗vfƂ̓ւō폜邽߁Az̏Ԃ͕ۑȂ.
+*/
+class ParticleEmitter
+{
+public:
+	ParticleEmitter(const ParticleEmitterParameter&, size_t maxParticleCount);
+	~ParticleEmitter() = default;
+	ParticleEmitter(const ParticleEmitter&) = delete;
+	ParticleEmitter& operator=(const ParticleEmitter&) = delete;
+
+	void Update(float deltaTime, ThreadPool* pool = nullptr);
+	void Stop() { isStopped = true; }
+	bool IsStopped() const { return isStopped; }
+	bool IsDead() const { return isStopped && count == 0; }
+
+	const ParticleEmitterParameter& Parameter() const { return param; }
+	void Position(const glm::vec3& p) { param.position = p; }
+	const glm::vec3& Position() const { return param.position; }
+	size_t Count() const { return count; }
+	size_t Capacity() const { return maxCount; }
+
+	// zւ̒ڃANZX. Y0`Count()-1.
+	const float* PositionX() const { return posX.data(); }
+	const float* PositionY() const { return posY.data(); }
+	const float* ColorR() const { return colorR.data(); }
+	const float* ColorG() const { return colorG.data(); }
+	const float* ColorB() const { return colorB.data(); }
+	const float* ColorA() const { return colorA.data(); }
+
+private:
+	void Emit(size_t n);
+	void Integrate(size_t begin, size_t end, float deltaTime);
+	void RemoveDead();
+
+	ParticleEmitterParameter param;
+	glm::vec4 colorDelta;	///< 1b̐F̕ω.
+	size_t maxCount;		///< őp[eBN.
+	size_t count = 0;		///< ݂̃p[eBN.
+	float emissionTimer = 0;	///< o̒[(b).
+	bool isStopped = false;	///< o~.
+	std::mt19937 random;
+
+	// p[eBN̗vfƂ̔z. 4PʂōXV邽߁A4̔{̑傫mۂ.
+	std::vector<float> posX, posY;
+	std::vector<float> velX, velY;
+	std::vector<float> colorR, colorG, colorB, colorA;
+	std::vector<float> life;	///< c(b).
+};
+using ParticleEmitterPtr = std::shared_ptr<ParticleEmitter>;
+
+/*
+	̃G~b^[܂Ƃ߂ĊǗNX.
+*/
+class ParticleSystem
+{
+public:
+	ParticleSystem() = default;
+	~ParticleSystem() = default;
+	ParticleSystem(const ParticleSystem&) = delete;
+	ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+	ParticleEmitterPtr Add(const ParticleEmitterParameter&, size_t maxParticleCount);
+	void Update(float deltaTime);
+	void Clear() { emitters.clear(); }
+	size_t ParticleCount() const;
+	const std::vector<ParticleEmitterPtr>& Emitters() const { return emitters; }
+
+	// XVɎgXbh(CXbh܂). 1Ȃ烁CXbhōXV.
+	void ThreadCount(size_t n) { pool.Resize(n > 0 ? n - 1 : 0); }
+	size_t ThreadCount() const { return pool.WorkerCount() + 1; }
+
+private:
+	std::vector<ParticleEmitterPtr> emitters;
+	ThreadPool pool;	///< SẴG~b^[ŋLƃXbh.
+};
+
+#endif // PARTICLE_H_INCLUDED
@@ -0,0 +1,109 @@
+/*
+	@file QuadIndexBuffer.cpp
+*/
+#include "QuadIndexBuffer.h"
+#include "GpuResourceRegistry.h"
+#include "GLDebug.h"
+#include <algorithm>
+#include <vector>
+#include <iostream>
+
+/*
+	CfbNXEobt@擾.
+
+	@return CfbNXEobt@̃VOgCX^X.
+*/
+QuadIndexBuffer& QuadIndexBuffer::Instance()
+{
+	static QuadIndexBuffer instance;
+	return instance;
+}
+
+/*
+	fXgN^.
+*/
+QuadIndexBuffer::~QuadIndexBuffer()
+{
+	GpuResourceRegistry::Instance().Unregister(GpuResourceType::Buffer, id);
+	glDeleteBuffers(1, &id);
+}
+
+/*
+	w肵̎lp``ł悤ɂ.
+
+	@param count	KvȎlp`̐.
+
+	@return `łlp`̐. maxQuadCount𒴂鐔͊mۂłȂ.
+
+	ɏ\ȐΉȂ.
+*/
+size_t QuadIndexBuffer::Reserve(size_t count)
+{
+	if (count > maxQuadCount) {
+		std::cerr << "[x]" << __func__ << ": lp`̐܂(" << count <<
+			"). " << maxQuadCount << "ɐ܂.\n";
+		count = maxQuadCount;
+	}
+	if (count <= quadCount) {
+		return quadCount;
+	}
+
+	// lp`ƂɃCfbNX6Kv(Op`2̒_).
+	std::vector<GLushort> indices(count * 6);
+	for (size_t i = 0; i < count; ++i) {
+		const GLushort n = static_cast<GLushort>(i * 4);
+		indices[i * 6 + 0] = n + 0;
+		indices[i * 6 + 1] = n + 1;
+		indices[i * 6 + 2] = n + 2;
+		indices[i * 6 + 3] = n + 2;
+		indices[i * 6 + 4] = n + 3;
+		indices[i * 6 + 5] = n + 0;
+	}
+
+	// VAOύXɍςނ悤ɁAID̂܂܃f[^蒼.
+	// GL_ELEMENT_ARRAY_BUFFERVAȌԂȂ̂ŁAGL_ARRAY_BUFFERƂăoCh.
+	GL_CALL_SITE();
+	// SĂ̕`NXŋL̂ŁAV[̏LƂĂ͐Ȃ.
+	if (!id) {
+		glGenBuffers(1, &id);
+		GpuResourceRegistry::OwnerScope owner("QuadIndexBuffer");
+		GpuResourceRegistry::Instance().Register(GpuResourceType::Buffer, id, 0, "QuadIndexBuffer::Reserve");
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, id);
+	glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (!GL_CALL_SUCCEEDED()) {
+		std::cerr << "[G[]" << __func__ << ": CfbNXEobt@̍쐬Ɏs.\n";
+		return quadCount;
+	}
+	GpuResourceRegistry::Instance().Resize(GpuResourceType::Buffer, id,
+		indices.size() * sizeof(GLushort));
+	quadCount = count;
+	return quadCount;
+}
+
+/*
+	lp``悷.
+
+	@param count	`悷CfbNX(6̔{).
+	@param offset	`JnCfbNX̃oCgItZbg.
+					CfbNXmaxQuadCount𒴂đĂƂ݂ȂʒuŎw肷.
+
+	maxQuadCountƂɋ؂AglDrawElementsBaseVertexŒ_̊Jnʒu炵ĕ`悷.
+	؂܂Ȃ1̕`ɂȂ. `悷VAOoChĂĂяo.
+*/
+void QuadIndexBuffer::DrawElements(GLsizei count, size_t offset)
+{
+	size_t quad = offset / (6 * sizeof(GLushort));
+	size_t remaining = static_cast<size_t>(count) / 6;
+	while (remaining > 0) {
+		const size_t chunk = quad / maxQuadCount;
+		const size_t local = quad - chunk * maxQuadCount;
+		const size_t n = std::min(remaining, maxQuadCount - local);
+		glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(n * 6), GL_UNSIGNED_SHORT,
+			reinterpret_cast<const GLvoid*>(local * 6 * sizeof(GLushort)),
+			static_cast<GLint>(chunk * maxQuadCount * 4));
+		quad += n;
+		remaining -= n;
+	}
+}
@@ -0,0 +1,41 @@
+/*
+	@file QuadIndexBuffer.h
+*/
+#ifndef QUADINDEXBUFFER_H_INCLUDED
+#define QUADINDEXBUFFER_H_INCLUDED
+#include <GL/glew.h>
+#include <stddef.h>
+
+/*
+	lp``悷邽߂̃CfbNXEobt@.
+
+	SĂ̎lp`͓(0,1,2,2,3,0)Ȃ̂ŁA1̃obt@SĂ̕`NXŋL.
+	KvȎlp`̐Ƃ蒼. obt@ID͕ςȂ̂ŁA
+	쐬ς݂VAO͂̂܂܎g.
+
+	CfbNXGLushortȂ̂ŁA1̕`ň̂maxQuadCount܂.
+	DrawElements()͂𒴂͈͂𕪊A_̊Jnʒu炵ĕ`悷.
+*/
+class QuadIndexBuffer
+{
+public:
+	static const size_t maxQuadCount = 65536 / 4;	///< GLushortŕ\ő̎lp`.
+
+	static QuadIndexBuffer& Instance();
+
+	size_t Reserve(size_t quadCount);
+	static void DrawElements(GLsizei count, size_t offset);
+	GLuint Id() const { return id; }
+	size_t QuadCount() const { return quadCount; }
+
+private:
+	QuadIndexBuffer() = default;
+	~QuadIndexBuffer();
+	QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+	QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+	GLuint id = 0;			///< ǗID.
+	size_t quadCount = 0;	///< CfbNX쐬ς݂̎lp`̐.
+};
+
+#endif // QUADINDEXBUFFER_H_INCLUDED
@@ -0,0 +1,329 @@
+/*
+	@file RenderCommandBuffer.cpp
+*/
+#include "RenderCommandBuffer.h"
+#include "QuadIndexBuffer.h"
+#include <algorithm>
+#include <iterator>
+#include <iostream>
+#include <string.h>
+
+/*
+	fXgN^.
+*/
+RenderCommandBuffer::~RenderCommandBuffer()
+{
+	if (samplesQuery) {
+		glDeleteQueries(1, &samplesQuery);
+	}
+}
+
+/*
+	בւL[쐬.
+
+	@param layer	`惌C[. قǐɕ`悳.
+	@param program	vOEIuWFNgID.
+	@param texture	eNX`EIuWFNgID.
+	@param depth	C[œԂ̃R}hׂ鏇.
+	@param blend	邩. falseȂsȃR}hƂāAC[Őɕ`悳.
+
+	@return בւL[.
+
+	sȃR}h͎O(depth傫)`悳悤ɁAdepth𔽓]Ċi[.
+	R}h͌납珇ɏd˂Kv̂ŁAdepthvOƃeNX`D悷.
+	depthɂAllocateDepth()ŊmۂԍgAق̕`NX̃R}hƏԂׂ悤ɂ邱.
+*/
+uint64_t RenderCommandBuffer::MakeSortKey(
+	uint8_t layer, GLuint program, GLuint texture, uint32_t depth, bool blend)
+{
+	const uint64_t state = (static_cast<uint64_t>(program & 0x7ff) << 20) |
+		static_cast<uint64_t>(texture & 0xfffff);
+	const uint64_t header = (static_cast<uint64_t>(layer) << 56) |
+		(static_cast<uint64_t>(blend ? 1 : 0) << 55);
+	if (blend) {
+		return header | (static_cast<uint64_t>(depth & 0xffffff) << 31) | state;
+	}
+	depth = 0xffffff - (depth & 0xffffff);
+	return header | (state << 24) | depth;
+}
+
+/*
+	SẴR}h.
+*/
+void RenderCommandBuffer::Clear()
+{
+	commands.clear();
+	views.clear();
+	std::fill(std::begin(layerQuadCounts), std::end(layerQuadCounts), 0);
+}
+
+/*
+	r[EvWFNVsǉ.
+
+	@param matVP	ǉs.
+	@param viewport	r[|[g(x, y, , ). nullptrȂExecute()Ăяo_̃r[|[gg.
+
+	@return RenderCommand::viewɐݒ肷ԍ.
+*/
+uint16_t RenderCommandBuffer::AddView(const glm::mat4& matVP, const GLint* viewport)
+{
+	View view;
+	view.matVP = matVP;
+	view.hasViewport = viewport != nullptr;
+	for (int i = 0; i < 4; ++i) {
+		view.viewport[i] = viewport ? viewport[i] : 0;
+	}
+
+	// OƓr[Ȃėp.
+	if (!views.empty() && views.back().hasViewport == view.hasViewport &&
+		memcmp(&views.back().matVP, &view.matVP, sizeof(glm::mat4)) == 0 &&
+		memcmp(views.back().viewport, view.viewport, sizeof(view.viewport)) == 0) {
+		return static_cast<uint16_t>(views.size() - 1);
+	}
+	views.push_back(view);
+	return static_cast<uint16_t>(views.size() - 1);
+}
+
+/*
+	R}hǉ.
+
+	@param command	ǉR}h.
+*/
+void RenderCommandBuffer::Add(const RenderCommand& command)
+{
+	commands.push_back(command);
+}
+
+/*
+	C[̐[x͈̔͂mۂ.
+
+	@param layer		`惌C[.
+	@param quadCount	`悷lp`̐.
+
+	@return RenderCommand::depthBaseɐݒ肷l.
+
+	قȂVAO̎lp`[xɂȂȂ悤ɁAC[ƂɊmۂɔԍ蓖Ă.
+	͈͂𒴂lp`́AO֌WȂȂƂ.
+*/
+GLint RenderCommandBuffer::AllocateDepth(uint8_t layer, size_t quadCount)
+{
+	const uint32_t base = layerQuadCounts[layer];
+	if (base + quadCount > maxLayerQuadCount) {
+		if (base <= maxLayerQuadCount) {
+			std::cerr << "[x]" << __func__ << ": C[" << static_cast<int>(layer) <<
+				"̎lp`" << maxLayerQuadCount << "𒴂܂.\n";
+		}
+		layerQuadCounts[layer] = static_cast<uint32_t>(maxLayerQuadCount + 1);
+		return static_cast<GLint>(std::min<size_t>(base, maxLayerQuadCount));
+	}
+	layerQuadCounts[layer] = static_cast<uint32_t>(base + quadCount);
+	return static_cast<GLint>(base);
+}
+
+/*
+	R}hבւL[̏ɕבւ.
+
+	8bit̊\[gs. ȃ\[gȂ̂ŁAL[̃R}h͒ǉɕ.
+	SẴL[œlɂȂĂ錅͔΂.
+*/
+void RenderCommandBuffer::Sort()
+{
+	const size_t n = commands.size();
+	if (n < 2) {
+		return;
+	}
+	sortBuffer.resize(n);
+
+	// SĂ̌̃qXgOxɍ쐬.
+	size_t histogram[8][256] = {};
+	for (const RenderCommand& e : commands) {
+		for (int pass = 0; pass < 8; ++pass) {
+			++histogram[pass][(e.sortKey >> (pass * 8)) & 0xff];
+		}
+	}
+
+	for (int pass = 0; pass < 8; ++pass) {
+		size_t* count = histogram[pass];
+		const uint8_t firstDigit = (commands[0].sortKey >> (pass * 8)) & 0xff;
+		if (count[firstDigit] == n) {
+			continue;
+		}
+		size_t sum = 0;
+		for (int i = 0; i < 256; ++i) {
+			const size_t tmp = count[i];
+			count[i] = sum;
+			sum += tmp;
+		}
+		for (const RenderCommand& e : commands) {
+			sortBuffer[count[(e.sortKey >> (pass * 8)) & 0xff]++] = e;
+		}
+		commands.swap(sortBuffer);
+	}
+}
+
+/*
+	`悵sNZ̃NǦʂ󂯎AI[o[h[XV.
+
+	ʂ͂܂GPU҂Ȃ悤ɁA܂ȂΑO̒l̂܂܂ɂ.
+*/
+void RenderCommandBuffer::UpdateOverdraw()
+{
+	if (!isQueryPending) {
+		return;
+	}
+	GLint available = 0;
+	glGetQueryObjectiv(samplesQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) {
+		return;
+	}
+	GLuint64 samples = 0;
+	glGetQueryObjectui64v(samplesQuery, GL_QUERY_RESULT, &samples);
+	isQueryPending = false;
+	if (queryViewportArea > 0) {
+		overdraw = static_cast<float>(samples) / static_cast<float>(queryViewportArea);
+	}
+}
+
+/*
+	R}hבւĎs.
+
+	vOAVAOAeNX`A̗L͕ωƂ؂ւ.
+	͏Zς݃At@ōŝŁAƉZ͓ݒŕ`悳.
+	ԂŁACfbNXAĂR}h1̕`ɂ܂Ƃ߂.
+
+	sȃR}h郌C[ł́A[xĂsȃR}hO`悵A
+	R}h͐[xeXgŉBꂽsNẐĂ. sȃR}hȂC[ł
+	[xeXgsȂ.
+	r[|[gȂr[͌Ăяo_̃r[|[gŕ`悵AIɂ͂ɖ߂.
+*/
+void RenderCommandBuffer::Execute()
+{
+	UpdateOverdraw();
+	drawCount = 0;
+	programChangeCount = 0;
+	textureChangeCount = 0;
+	blendChangeCount = 0;
+	if (commands.empty()) {
+		return;
+	}
+	Sort();
+
+	// r[ƂɕύXr[|[gAIɖ߂߂ɕۑĂ.
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	// ÕNǦʂ󂯎Ă΁A̕`̃sNZ𐔂.
+	if (!samplesQuery) {
+		glGenQueries(1, &samplesQuery);
+	}
+	const bool beginQuery = !isQueryPending;
+	if (beginQuery) {
+		queryViewportArea = viewport[2] * viewport[3];
+		glBeginQuery(GL_SAMPLES_PASSED, samplesQuery);
+	}
+
+	glDisable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	Shader::Program* program = nullptr;
+	bool blend = true;
+	bool depthTest = false;
+	int layer = -1;
+	GLuint vao = 0;
+	GLuint texture = 0;
+	GLenum textureTarget = GL_TEXTURE_2D;
+	int view = -1;
+	GLint depthBase = -1;
+	for (size_t i = 0; i < commands.size(); ++i) {
+		const RenderCommand& e = commands[i];
+
+		// C[̐擪ŁAsȃR}hΐ[xg.
+		// sȃR}h̓C[Őɕł.
+		const int commandLayer = static_cast<int>(e.sortKey >> 56);
+		if (commandLayer != layer) {
+			layer = commandLayer;
+			if (!e.blend) {
+				glDepthMask(GL_TRUE);
+				glClear(GL_DEPTH_BUFFER_BIT);
+				glEnable(GL_DEPTH_TEST);
+				depthTest = true;
+			} else if (depthTest) {
+				glDisable(GL_DEPTH_TEST);
+				depthTest = false;
+			}
+		}
+
+		if (e.program != program) {
+			program = e.program;
+			program->Use();
+			view = -1;
+			depthBase = -1;
+			++programChangeCount;
+		}
+		if (e.view != view) {
+			view = e.view;
+			program->SetViewProjectionMatrix(views[view].matVP);
+			// r[|[gȂr[́AExecute()Ăяo_̃r[|[gŕ`悷.
+			const GLint* vp = views[view].hasViewport ? views[view].viewport : viewport;
+			glViewport(vp[0], vp[1], vp[2], vp[3]);
+		}
+		if (e.depthBase != depthBase) {
+			depthBase = e.depthBase;
+			program->SetDepthBase(depthBase);
+		}
+		if (e.vao != vao) {
+			vao = e.vao;
+			glBindVertexArray(vao);
+		}
+		if (e.texture != texture) {
+			texture = e.texture;
+			textureTarget = e.textureTarget;
+			program->BindTexture(0, texture, textureTarget);
+			++textureChangeCount;
+		}
+		if (e.blend != blend) {
+			blend = e.blend;
+			if (blend) {
+				glEnable(GL_BLEND);
+			} else {
+				glDisable(GL_BLEND);
+			}
+			// R}h͐[xeXgsA[x͏܂Ȃ.
+			if (depthTest) {
+				glDepthMask(blend ? GL_FALSE : GL_TRUE);
+			}
+			++blendChangeCount;
+		}
+
+		// 㑱̃R}hA͈͂`悷ȂA܂Ƃ߂ĕ`悷.
+		GLsizei count = e.count;
+		for (; i + 1 < commands.size(); ++i) {
+			const RenderCommand& next = commands[i + 1];
+			if (next.program != e.program || next.vao != e.vao ||
+				next.texture != e.texture || next.view != e.view || next.blend != e.blend ||
+				next.depthBase != e.depthBase ||
+				next.offset != e.offset + count * sizeof(GLushort)) {
+				break;
+			}
+			count += next.count;
+		}
+		QuadIndexBuffer::DrawElements(count, e.offset);
+		++drawCount;
+	}
+	if (program) {
+		program->BindTexture(0, 0, textureTarget);
+	}
+	glBindVertexArray(0);
+	if (!blend) {
+		glEnable(GL_BLEND);
+	}
+	glDepthMask(GL_TRUE);
+	glDisable(GL_DEPTH_TEST);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	if (beginQuery) {
+		glEndQuery(GL_SAMPLES_PASSED);
+		isQueryPending = true;
+	}
+}
@@ -0,0 +1,95 @@
+/*
+	@file RenderCommandBuffer.h
+*/
+#ifndef RENDERCOMMANDBUFFER_H_INCLUDED
+#define RENDERCOMMANDBUFFER_H_INCLUDED
+#include "Shader.h"
+#include <GL/glew.h>
+#include <glm/mat4x4.hpp>
+#include <vector>
+#include <stdint.h>
+
+/*
+	`R}h.
+*/
+struct RenderCommand
+{
+	uint64_t sortKey;			///< בւL[.
+	Shader::Program* program;	///< `ɎgVF[_[EvO.
+	GLuint vao;					///< `ɎgVAO.
+	GLuint texture;				///< `ɎgeNX`.
+	GLenum textureTarget = GL_TEXTURE_2D;	///< eNX`̎.
+	GLsizei count;				///< `悷CfbNX.
+	size_t offset;				///< `JnCfbNX̃oCgItZbg(QuadIndexBuffer::DrawElements()Q).
+	uint16_t view;				///< r[EvWFNVs̔ԍ.
+	GLint depthBase = 0;		///< [x߂ƂɎlp`̔ԍɉl(AllocateDepth()Ŏ擾).
+	bool blend = true;			///< Zς݃At@ō邩. falseȂ㏑.
+};
+
+/*
+	`R}h𗭂߂ĂAԂ̐؂ւȂȂ鏇ԂŎsNX.
+
+	sȃR}h̕בւL[͏ʃrbg C[(8bit)A(1bit)AvO(11bit)A
+	eNX`(20bit)A[x(24bit)̏ɕł. dȂ͐[xeXgŉ̂ŁA
+	vOƃeNX`ł܂Ƃ߂ďԂ̐؂ւ炷.
+	R}h͐[xeXgł͏dȂłȂ߁A[xvOƃeNX`
+	ʂɒuAǉԂۂ.
+
+	eC[ł͕sȃR}hɁA[x݂ȂO珇ɕ`悵A
+	čR}h[xeXgLɂĕ`悷.
+	[x͎lp`̔ԍ̂ŁA`NXAllocateDepth()ŃC[̔ԍ͈̔͂mۂA
+	RenderCommand::depthBaseɐݒ肷邱. ォmۂ͈͂قǎOɂȂ.
+*/
+class RenderCommandBuffer
+{
+public:
+	RenderCommandBuffer() = default;
+	~RenderCommandBuffer();
+	RenderCommandBuffer(const RenderCommandBuffer&) = delete;
+	RenderCommandBuffer& operator=(const RenderCommandBuffer&) = delete;
+
+	static uint64_t MakeSortKey(uint8_t layer, GLuint program, GLuint texture, uint32_t depth,
+		bool blend = true);
+
+	void Clear();
+	uint16_t AddView(const glm::mat4& matVP, const GLint* viewport = nullptr);
+	void Add(const RenderCommand&);
+	GLint AllocateDepth(uint8_t layer, size_t quadCount);
+	void Execute();
+	size_t Size() const { return commands.size(); }
+
+	// OExecute()̓v.
+	size_t DrawCount() const { return drawCount; }
+	size_t ProgramChangeCount() const { return programChangeCount; }
+	size_t TextureChangeCount() const { return textureChangeCount; }
+	size_t BlendChangeCount() const { return blendChangeCount; }
+	float Overdraw() const { return overdraw; }
+
+private:
+	void Sort();
+	void UpdateOverdraw();
+
+	std::vector<RenderCommand> commands;
+	std::vector<RenderCommand> sortBuffer;	///< בւp̍Ɨ̈.
+	// r[Ƃ̐ݒ.
+	struct View {
+		glm::mat4 matVP;		///< r[EvWFNVs.
+		GLint viewport[4];		///< r[|[g.
+		bool hasViewport;		///< p̃r[|[g.
+	};
+	std::vector<View> views;
+
+	static const size_t maxLayerQuadCount = 1 << 20;	///< 1̃C[Ő[xʂłlp`̐.
+	uint32_t layerQuadCounts[256] = {};	///< C[ƂɊmۍς݂̎lp`̐.
+
+	size_t drawCount = 0;
+	size_t programChangeCount = 0;
+	size_t textureChangeCount = 0;
+	size_t blendChangeCount = 0;
+	float overdraw = 0;				///< `悵sNZr[|[g̃sNZ.
+	GLuint samplesQuery = 0;		///< `悵sNZ𐔂NG.
+	bool isQueryPending = false;	///< NǦʂ҂Ă邩.
+	GLint queryViewportArea = 0;	///< NGJñr[|[g̃sNZ.
+};
+
+#endif // RENDERCOMMANDBUFFER_H_INCLUDED
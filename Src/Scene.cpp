@@ -2,6 +2,8 @@
 	@file Scene.cpp
 */
 #include "Scene.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
 #include <iostream>
 
 /*
@@ -16,11 +18,14 @@ Scene::Scene(const char* name) : name(name)
 
 /*
 	fXgN^.
+
+	hNX̃o͔jς݂Ȃ̂ŁÃV[GPU\[XcĂΉRƂĕ񍐂.
 */
 Scene::~Scene()
 {
 	Finalize();
 	std::cout << "Scene fXgN^: " << name << "\n";
+	GpuResourceRegistry::Instance().ReportLeaks(name, std::cerr);
 }
 
 /*
@@ -113,17 +118,170 @@ SceneStack::SceneStack()
 }
 
 /*
-	V[vbV.
+	V[̃vbV\񂷂.
 
 	@param p VV[.
+
+	ۂ̃vbV͎Update()̊Jnɍs.
+	Preload()̃V[̏ꍇAǂݍ݂I܂őJڂ͕ۗ.
 */
 void SceneStack::Push(ScenePtr p)
 {
+	transitions.push_back({ Transition::Push, p });
+}
+
+/*
+	V[̃|bv\񂷂.
+
+	ۂ̃|bv͎Update()̊Jnɍs.
+*/
+void SceneStack::Pop()
+{
+	transitions.push_back({ Transition::Pop, nullptr });
+}
+
+/*
+	V[̒u\񂷂.
+
+	@param p VV[.
+
+	ۂ̒u͎Update()̊Jnɍs.
+	Preload()̃V[̏ꍇAǂݍ݂I܂őJڂ͕ۗ.
+*/
+void SceneStack::Replace(ScenePtr p)
+{
+	transitions.push_back({ Transition::Replace, p });
+}
+
+/*
+	V[̓ǂݍ݂obNOEhŊJn.
+
+	@param p ǂݍރV[.
+
+	ʃXbhScene::Preload()s.
+	ǂݍ݂IOPush()Replace()ꍇAJڂ͓ǂݍ݂I܂ŕۗ.
+	JڂɑSĂ̎QƂꂽV[́Aǂݍ݂IUpdate()Ŕj.
+*/
+void SceneStack::Preload(ScenePtr p)
+{
+	if (IsLoaded(p)) {
+		return;
+	}
+	for (const Loading& e : loadings) {
+		if (e.scene == p) {
+			return;
+		}
+	}
+	std::cout << "[V[ v[h]" << p->Name() << "\n";
+	// QƐŎgȂȂƂ𔻒ł悤ɁAXbhɂ̓|C^n.
+	// V[loadingsێĂ̂ŁAǂݍݒɔj邱Ƃ͂Ȃ.
+	Scene* scene = p.get();
+	loadings.push_back({ p, std::async(std::launch::async, [scene]() { return scene->Preload(); }) });
+}
+
+/*
+	V[̃obNOEhǂݍ݂IĂ邩ׂ.
+
+	@param p ׂV[.
+
+	@retval true	ǂݍݍς݁A܂Preload()ĂȂ.
+	@retval false	ǂݍݒ.
+*/
+bool SceneStack::IsLoaded(const ScenePtr& p) const
+{
+	for (const Loading& e : loadings) {
+		if (e.scene == p) {
+			return e.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+	}
+	return true;
+}
+
+/*
+	\񂳂ꂽV[Jڂs.
+
+	V[̍XVɃX^bNωȂ悤ɁAJڂ̓t[̋؂ł܂Ƃ߂čs.
+	ǂݍݒ̃V[ւ̑Jڂ΁AŒfĎ̃t[Ɏz.
+*/
+void SceneStack::ApplyTransitions()
+{
+	ReapLoadings();
+	size_t i = 0;
+	for (; i < transitions.size(); ++i) {
+		const Transition& e = transitions[i];
+		if (e.scene && !IsLoaded(e.scene)) {
+			break;
+		}
+		switch (e.type) {
+		case Transition::Push: PushNow(e.scene); break;
+		case Transition::Pop: PopNow(); break;
+		case Transition::Replace: ReplaceNow(e.scene); break;
+		}
+	}
+	transitions.erase(transitions.begin(), transitions.begin() + i);
+}
+
+/*
+	gȂȂǂݍݍς݂̃V[j.
+
+	V[X^bNQƂĂV[́AJڐƂĎg邱ƂȂ.
+	ǂݍݒ̃V[̓XbhgĂ̂ŁAI܂ő҂Ăj.
+*/
+void SceneStack::ReapLoadings()
+{
+	loadings.erase(std::remove_if(loadings.begin(), loadings.end(), [](Loading& e) {
+		if (e.scene.use_count() > 1 ||
+			e.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return false;
+		}
+		e.result.get();
+		std::cout << "[V[ v[h] gȂV[j܂: " << e.scene->Name() << "\n";
+		return true;
+	}), loadings.end());
+}
+
+/*
+	V[̓ǂݍ݂.
+
+	@param p ǂݍރV[.
+
+	@retval true	ǂݍݐ.
+	@retval false	ǂݍݎs.
+
+	Preload()ĂȂV[̏ꍇAœIScene::Preload()s.
+*/
+bool SceneStack::WaitPreload(const ScenePtr& p)
+{
+	for (auto itr = loadings.begin(); itr != loadings.end(); ++itr) {
+		if (itr->scene == p) {
+			const bool result = itr->result.get();
+			loadings.erase(itr);
+			return result;
+		}
+	}
+	return p->Preload();
+}
+
+/*
+	V[vbV.
+
+	@param p VV[.
+
+	V[̓ǂݍ݂Ɏsꍇ́AX^bNύXɑJڂ𒆎~.
+*/
+void SceneStack::PushNow(ScenePtr p)
+{
+	if (!WaitPreload(p)) {
+		std::cerr << "[V[ vbV] [G[]" << p->Name() <<
+			"̓ǂݍ݂Ɏs߁AJڂ𒆎~܂.\n";
+		return;
+	}
 	if (!stack.empty()) {
 		Current().Stop();
 	}
 	stack.push_back(p);
 	std::cout << "[V[ vbV]" << p->Name() << "\n";
+	GpuResourceRegistry::OwnerScope owner(p->Name());
 	Current().Initialize();
 	Current().Play();
 }
@@ -131,14 +289,17 @@ void SceneStack::Push(ScenePtr p)
 /*
 	V[|bv.
 */
-void SceneStack::Pop()
+void SceneStack::PopNow()
 {
 if (stack.empty()) {
 	std::cout << "[V[ |bv] [x] V[X^bNł.\n";
 	return;
 }
 Current().Stop();
-Current().Finalize();
+{
+	GpuResourceRegistry::OwnerScope owner(Current().Name());
+	Current().Finalize();
+}
 const std::string sceneName = Current().Name();
 stack.pop_back();
 std::cout << "[V[ |bv]" << sceneName << "\n";
@@ -151,9 +312,16 @@ if (!stack.empty()) {
 	V[u.
 
 	@param p VV[.
+
+	V[̓ǂݍ݂Ɏsꍇ́Ã݂V[c܂ܑJڂ𒆎~.
 */
-void SceneStack::Replace(ScenePtr p)
+void SceneStack::ReplaceNow(ScenePtr p)
 {
+	if (!WaitPreload(p)) {
+		std::cerr << "[V[ v[X] [G[]" << p->Name() <<
+			"̓ǂݍ݂Ɏs߁AJڂ𒆎~܂.\n";
+		return;
+	}
 	std::string sceneName = "(Empty)";
 	if (stack.empty()) {
 		std::cout << "[V[ v[X] [x]V[X^bNł.\n";
@@ -161,11 +329,13 @@ void SceneStack::Replace(ScenePtr p)
 	else {
 		sceneName = Current().Name();
 		Current().Stop();
+		GpuResourceRegistry::OwnerScope owner(sceneName);
 		Current().Finalize();
 		stack.pop_back();
 	}
 	stack.push_back(p);
 	std::cout << "[V[ v[X]" << sceneName << " -> " << p->Name() << "\n";
+	GpuResourceRegistry::OwnerScope owner(p->Name());
 	Current().Initialize();
 	Current().Play();
 }
@@ -218,11 +388,14 @@ bool SceneStack::Empty() const
 */
 void SceneStack::Update(float deltaTime)
 {
+	ApplyTransitions();
 	if (!Empty()) {
+		GpuResourceRegistry::OwnerScope owner(Current().Name());
 		Current().ProcessInput();
 	}
 	for (ScenePtr& e : stack) {
 		if (e->IsActive()) {
+			GpuResourceRegistry::OwnerScope owner(e->Name());
 			e->Update(deltaTime);
 		}
 	}
@@ -230,12 +403,45 @@ void SceneStack::Update(float deltaTime)
 
 /*
 	V[`悷.
+
+	eV[Render()CommandBuffer()ɕ`R}hǉ.
+	SV[̃R}h͍Ōɂ܂Ƃ߂ĕבւAs.
 */
 void SceneStack::Render()
 {
+	commandBuffer.Clear();
 	for (ScenePtr& e : stack) {
 		if (e->IsVisible()) {
+		GpuResourceRegistry::OwnerScope owner(e->Name());
 		e->Render();
 		}
 	}
+	commandBuffer.Execute();
+	AccumulateRenderStatistics();
+}
+
+/*
+	`擝v~ςAt[ƂɕςOɏo͂.
+
+	̐؂ւ񐔂ƃI[o[h[́AsȃXvCgOĕ`悷ʂm߂邽߂Ɏg.
+*/
+void SceneStack::AccumulateRenderStatistics()
+{
+	// 60fpsŖ10bƂɏo͂.
+	static const size_t reportInterval = 600;
+
+	RenderStatistics& s = renderStatistics;
+	++s.frameCount;
+	s.drawCount += commandBuffer.DrawCount();
+	s.blendChangeCount += commandBuffer.BlendChangeCount();
+	s.overdraw += commandBuffer.Overdraw();
+	if (s.frameCount < reportInterval) {
+		return;
+	}
+	const double n = static_cast<double>(s.frameCount);
+	std::cout << "[`擝v] " << s.frameCount << "t[̕" <<
+		" draw:" << s.drawCount / n <<
+		" blend change:" << s.blendChangeCount / n <<
+		" overdraw:" << s.overdraw / n << "\n";
+	s = RenderStatistics();
 }
@@ -7,6 +7,8 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <future>
+#include "RenderCommandBuffer.h"
 
 class SceneStack;
 
@@ -20,6 +22,7 @@ public:
 	Scene& operator=(const Scene&) = delete;
 	virtual ~Scene();
 
+	virtual bool Preload() { return true; }
 	virtual bool Initialize() = 0 {}
 	virtual void ProcessInput() = 0 {}
 	virtual void Update(float) = 0 {}
@@ -53,6 +56,9 @@ public:
 	void Push(ScenePtr);
 	void Pop();
 	void Replace(ScenePtr);
+	void Preload(ScenePtr);
+	bool IsLoaded(const ScenePtr&) const;
+	bool IsTransitionPending() const { return !transitions.empty(); }
 	Scene& Current();
 	const Scene& Current() const;
 	size_t Size() const;
@@ -60,6 +66,7 @@ public:
 	
 	void Update(float);
 	void Render();
+	RenderCommandBuffer& CommandBuffer() { return commandBuffer; }
 
 private:
 	SceneStack();
@@ -67,7 +74,38 @@ private:
 	SceneStack& operator=(const SceneStack&) = delete;
 	~SceneStack() = default;
 
+	void ApplyTransitions();
+	void ReapLoadings();
+	bool WaitPreload(const ScenePtr&);
+	void PushNow(ScenePtr);
+	void PopNow();
+	void ReplaceNow(ScenePtr);
+	void AccumulateRenderStatistics();
+
 	std::vector<ScenePtr> stack;
+	RenderCommandBuffer commandBuffer;	///< SV[̕`R}h.
+
+	// t[ƂɃO֏o͂`擝v̍v.
+	struct RenderStatistics {
+		size_t frameCount = 0;
+		size_t drawCount = 0;
+		size_t blendChangeCount = 0;
+		double overdraw = 0;
+	} renderStatistics;
+
+	// \񂳂ꂽV[J.
+	struct Transition {
+		enum Type { Push, Pop, Replace } type;
+		ScenePtr scene;
+	};
+	std::vector<Transition> transitions;
+
+	// obNOEhœǂݍݒ̃V[.
+	struct Loading {
+		ScenePtr scene;
+		std::future<bool> result;
+	};
+	std::vector<Loading> loadings;
 };
 
 #endif // !SCENE_H_INCLUDED
@@ -2,10 +2,14 @@
 	@file Shader.cpp
 */
 #include "Shader.h"
+#include "ShaderReloader.h"
+#include "GpuResourceRegistry.h"
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <stdint.h>
+#include <algorithm>
+#include <string>
 #include <glm/gtc/matrix_transform.hpp>
 
 /*
@@ -51,6 +55,21 @@ namespace Shader{
 		return shader;
 	}
 
+/*
+	NvOEIuWFNgGPU\[XƂēo^.
+
+	@param program	o^vOEIuWFNg.
+
+	vÕoCiTCYAGPU̎gpʂƂ݂Ȃ.
+*/
+	void RegisterProgram(GLuint program)
+	{
+		GLint binaryLength = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		GpuResourceRegistry::Instance().Register(GpuResourceType::Program, program,
+			binaryLength, "Shader::Build");
+	}
+
 /*
 	vOEIuWFNg쐬.
 
@@ -90,9 +109,152 @@ namespace Shader{
 			glDeleteProgram(program);
 			return 0;
 		}
+		RegisterProgram(program);
 		return program;
 	}
 
+/*
+	Rs[gVF[_[̃vOEIuWFNg쐬.
+
+	@param csCode	Rs[gVF[_[EvOւ̃|C^.
+
+	@retval 0 傫@쐬vOEIuWFNg.
+	@retval 0			@vOEIuWFNg̍쐬Ɏs.
+*/
+	GLuint BuildCompute(const GLchar* csCode)
+	{
+		const GLuint cs = Compile(GL_COMPUTE_SHADER, csCode);
+		if (!cs) {
+			return 0;
+		}
+		const GLuint program = glCreateProgram();
+		glAttachShader(program, cs);
+		glDeleteShader(cs);
+		glLinkProgram(program);
+		return EndBuild(program);
+	}
+
+/*
+	t@CRs[gVF[_[̃vOEIuWFNg쐬.
+
+	@param csPath	Rs[gVF[_[Et@C.
+	@param defines	VF[_[ɒǉ#define.
+
+	@retval 0 傫@쐬vOEIuWFNg.
+	@retval 0			@vOEIuWFNg̍쐬Ɏs.
+*/
+	GLuint BuildComputeFromFile(const char* csPath, const char* defines)
+	{
+		const std::vector<GLchar> csCode = InsertDefines(ReadFile(csPath), defines);
+		if (csCode.empty()) {
+			return 0;
+		}
+		return BuildCompute(csCode.data());
+	}
+
+/*
+	vOEIuWFNg̍쐬Jn.
+
+	@param vsCode	_VF[_[EvOւ̃|C^.
+	@param fsCode	tOgVF[_[EvOւ̃|C^.
+
+	@retval 0 傫@ÑvOEIuWFNg.
+	@retval 0			@vOEIuWFNg̍쐬Ɏs.
+
+	RpCƃŇʂ҂ɖ߂.
+	GL_KHR_parallel_shader_compileɑΉĂ΁AhCõXbhŃRpCiނ̂ŁA
+	IsBuildCompleted()ŊmFĂEndBuild()ĂԂƑ҂ԂȂ.
+*/
+	GLuint BeginBuild(const GLchar* vsCode, const GLchar* fsCode)
+	{
+		if (!vsCode || !fsCode) {
+			return 0;
+		}
+		const GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(vs, 1, &vsCode, nullptr);
+		glCompileShader(vs);
+		const GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(fs, 1, &fsCode, nullptr);
+		glCompileShader(fs);
+
+		// VF[_[̓vO폜܂ŎcAEndBuild()ŃG[擾ł.
+		const GLuint program = glCreateProgram();
+		glAttachShader(program, vs);
+		glDeleteShader(vs);
+		glAttachShader(program, fs);
+		glDeleteShader(fs);
+		glLinkProgram(program);
+		return program;
+	}
+
+/*
+	vOEIuWFNg̃NIׂ.
+
+	@param program	BeginBuild()ō쐬vOEIuWFNg.
+
+	@retval true	NI. ܂́A𒲂ׂ@\Ȃ.
+	@retval false	N.
+*/
+	bool IsBuildCompleted(GLuint program)
+	{
+		if (!GLEW_KHR_parallel_shader_compile) {
+			return true;
+		}
+		GLint completed = GL_TRUE;
+		glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+		return completed == GL_TRUE;
+	}
+
+/*
+	vOEIuWFNg̍쐬.
+
+	@param program	BeginBuild()ō쐬vOEIuWFNg.
+
+	@retval 0 傫@쐬vOEIuWFNg.
+	@retval 0			@vOEIuWFNg̍쐬Ɏs.
+
+	sꍇAR\[ɏo͂ăvOEIuWFNg폜.
+*/
+	GLuint EndBuild(GLuint program)
+	{
+		if (!program) {
+			return 0;
+		}
+		GLint linkStatus = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+		if (linkStatus == GL_TRUE) {
+			RegisterProgram(program);
+			return program;
+		}
+
+		// VF[_[̃RpCG[o͂.
+		GLuint shaders[2];
+		GLsizei shaderCount = 0;
+		glGetAttachedShaders(program, 2, &shaderCount, shaders);
+		for (GLsizei i = 0; i < shaderCount; ++i) {
+			GLint compiled = GL_FALSE;
+			glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+			GLint infoLen = 0;
+			glGetShaderiv(shaders[i], GL_INFO_LOG_LENGTH, &infoLen);
+			if (!compiled && infoLen) {
+				std::vector<char> buf(infoLen);
+				glGetShaderInfoLog(shaders[i], infoLen, nullptr, buf.data());
+				std::cerr << "ERROR: VF[_[̃RpCɎs.\n" << buf.data() << std::endl;
+			}
+		}
+
+		// NG[o͂.
+		GLint infoLen = 0;
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
+		if (infoLen) {
+			std::vector<char> buf(infoLen);
+			glGetProgramInfoLog(program, infoLen, nullptr, buf.data());
+			std::cerr << "ERROR: VF[_[̃NɎs.\n" << buf.data() << std::endl;
+		}
+		glDeleteProgram(program);
+		return 0;
+	}
+
 /*
 	t@Cǂݍ.
 
@@ -119,21 +281,143 @@ namespace Shader{
 		return buf;
 	}
 
+/*
+	VF[_[#versionš#defineǉ.
+
+	@param code		VF[_[EvO.
+	@param defines	ǉ#define. nullptrȂ牽Ȃ.
+
+	@return #defineǉVF[_[EvO.
+
+	G[̍sԍt@Cƈv悤ɁA#lineǉ.
+*/
+	std::vector<GLchar> InsertDefines(const std::vector<GLchar>& code, const char* defines)
+	{
+		if (!defines || !*defines || code.empty()) {
+			return code;
+		}
+		std::vector<GLchar>::const_iterator pos = code.begin();
+		static const char versionDirective[] = "#version";
+		const auto itr = std::search(code.begin(), code.end(),
+			versionDirective, versionDirective + sizeof(versionDirective) - 1);
+		if (itr != code.end()) {
+			pos = std::find(itr, code.end(), '\n');
+			if (pos != code.end()) {
+				++pos;
+			}
+		}
+		const int line = static_cast<int>(std::count(code.begin(), pos, '\n')) + 1;
+		const std::string header = std::string(defines) + "#line " + std::to_string(line) + "\n";
+
+		std::vector<GLchar> result;
+		result.reserve(code.size() + header.size());
+		result.insert(result.end(), code.begin(), pos);
+		result.insert(result.end(), header.begin(), header.end());
+		result.insert(result.end(), pos, code.end());
+		return result;
+	}
+
 	/*
 		t@CvOEIuWFNg쐬.
 
 		@param vsPath	_f[^Et@C.
 		@param fsPath	tOgVF[_[Et@C.
+		@param defines	VF[_[ɒǉ#define.
 
 		@return	쐬vOEIuWFNg.
 	*/
-	GLuint BuildFromFile(const char* vsPath, const char* fsPath)
+	GLuint BuildFromFile(const char* vsPath, const char* fsPath, const char* defines)
 	{
-		const std::vector<GLchar> vsCode = ReadFile(vsPath);
-		const std::vector<GLchar> fsCode = ReadFile(fsPath);
+		const std::vector<GLchar> vsCode = InsertDefines(ReadFile(vsPath), defines);
+		const std::vector<GLchar> fsCode = InsertDefines(ReadFile(fsPath), defines);
+		if (vsCode.empty() || fsCode.empty()) {
+			return 0;
+		}
 		return Build(vsCode.data(), fsCode.data());
 	}
 
+/*
+	RXgN^.
+
+	@param programId	vOEIuWFNgID.
+*/
+	Program::Program(GLuint programId)
+	{
+		Reset(programId);
+	}
+
+/*
+	fXgN^.
+*/
+	Program::~Program()
+	{
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Program, id);
+		glDeleteProgram(id);
+	}
+
+/*
+	vOEIuWFNgݒ肷.
+
+	@param programId	vOEIuWFNgID.
+
+	ȑÕvOEIuWFNg͍폜.
+	uniformϐ̈ʒu擾Aݒς݂̃CgVvOɓ].
+*/
+	void Program::Reset(GLuint programId)
+	{
+		GpuResourceRegistry::Instance().Inherit(GpuResourceType::Program, programId, id);
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Program, id);
+		glDeleteProgram(id);
+		id = programId;
+		if (!id) {
+			locMatMVP = locMatModel = locDepthBase = -1;
+			locAmbLightCol = locDirLightDir = locDirLightCol = -1;
+			locPointLightPos = locPointLightCol = -1;
+			locSpotLightDir = locSpotLightPos = locSpotLightCol = -1;
+			return;
+		}
+		locMatMVP = glGetUniformLocation(id, "matMVP");
+		locMatModel = glGetUniformLocation(id, "matModel");
+		locDepthBase = glGetUniformLocation(id, "depthBase");
+		locAmbLightCol = glGetUniformLocation(id, "ambientLight.color");
+		locDirLightDir = glGetUniformLocation(id, "directionalLight.direction");
+		locDirLightCol = glGetUniformLocation(id, "directionalLight.color");
+		locPointLightPos = glGetUniformLocation(id, "pointLight.position");
+		locPointLightCol = glGetUniformLocation(id, "pointLight.color");
+		locSpotLightDir = glGetUniformLocation(id, "spotLight.dirAndCutOff");
+		locSpotLightPos = glGetUniformLocation(id, "spotLight.posAndInnerCutOff");
+		locSpotLightCol = glGetUniformLocation(id, "spotLight.color");
+
+		if (hasLightList) {
+			GLint currentProgram = 0;
+			glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+			glUseProgram(id);
+			SetLightList(lights);
+			glUseProgram(currentProgram);
+		}
+	}
+
+/*
+	vOEIuWFNg`Ɏgp.
+*/
+	void Program::Use()
+	{
+		glUseProgram(id);
+	}
+
+/*
+	eNX`eNX`EC[WEjbgɊ蓖Ă.
+
+	@param unitNo	蓖Ă郆jbgԍ(0`).
+	@param texId	蓖ĂeNX`ID.
+	@param target	eNX`̎.
+*/
+	void Program::BindTexture(GLuint unitNo, GLuint texId, GLenum target)
+	{
+		glActiveTexture(GL_TEXTURE0 + unitNo);
+		glBindTexture(target, texId);
+	}
+
 /*
 	`Ɏg郉Cgݒ肷.
 
@@ -142,6 +426,7 @@ namespace Shader{
 	void Program::SetLightList(const LightList& lights)
 	{
 		this->lights = lights;
+		hasLightList = true;
 
 		// Cg̐FGPUɓ].
 		if (locAmbLightCol >= 0) {
@@ -173,6 +458,18 @@ namespace Shader{
 		}
 	}
 
+/*
+	[x߂ƂɎlp`̔ԍɉlݒ肷.
+
+	@param base	l. PƂŕ`悷ꍇ0.
+*/
+	void Program::SetDepthBase(GLint base)
+	{
+		if (locDepthBase >= 0) {
+			glUniform1i(locDepthBase, base);
+		}
+	}
+
 
 /*
 	bV`悷.
@@ -259,9 +556,73 @@ namespace Shader{
 
 	@return	쐬vOEIuWFNg.
 */
-	ProgramPtr Program::Create(const char* vsPath, const char* fsPath)
+	ProgramPtr Program::Create(const char* vsPath, const char* fsPath, const char* defines)
+	{
+		ProgramPtr p = std::make_shared<Program>(BuildFromFile(vsPath, fsPath, defines));
+		if (!p->Id()) {
+			std::cerr << "[G[]" << __func__ << ": " << vsPath << ", " << fsPath <<
+				" VF[_[쐬ł܂.\n";
+		}
+
+		// 쐬ɎsꍇAt@CC΍ēǂݍ݂.
+		Reloader::Instance().Watch(p, vsPath, fsPath, defines);
+		return p;
+	}
+
+/*
+	ނɑΉ#define쐬.
+
+	@return @\tO`#define.
+*/
+	std::string Permutation::Defines() const
 	{
-		return std::make_shared<Program>(BuildFromFile(vsPath, fsPath));
+		std::string defines;
+		if (features & Feature_Textured) {
+			defines += "#define TEXTURED\n";
+		}
+		if (features & Feature_TextureArray) {
+			defines += "#define TEXTURE_ARRAY\n";
+		}
+		if (features & Feature_Bindless) {
+			defines += "#define BINDLESS\n";
+		}
+		return defines;
+	}
+
+/*
+	vOELbV擾.
+
+	@return vOELbṼVOgCX^X.
+*/
+	ProgramCache& ProgramCache::Instance()
+	{
+		static ProgramCache instance;
+		return instance;
+	}
+
+/*
+	ނɑΉvO擾.
+
+	@param vsPath		_VF[_[Et@C.
+	@param fsPath		tOgVF[_[Et@C.
+	@param permutation	vO̎.
+
+	@return 쐬ς݂̃vO. ȂΐV쐬vO.
+*/
+	ProgramPtr ProgramCache::Get(const char* vsPath, const char* fsPath,
+		const Permutation& permutation)
+	{
+		const std::string key = std::string(vsPath) + '|' + fsPath + '|' +
+			std::to_string(permutation.Key());
+		const auto itr = programs.find(key);
+		if (itr != programs.end()) {
+			return itr->second;
+		}
+		// SẴV[ŋL̂ŁAV[̏LƂĂ͐Ȃ.
+		GpuResourceRegistry::OwnerScope owner("Shader::ProgramCache");
+		const ProgramPtr p = Program::Create(vsPath, fsPath, permutation.Defines().c_str());
+		programs.emplace(key, p);
+		return p;
 	}
 
 } // Shader namespace
\ No newline at end of file
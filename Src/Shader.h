@@ -7,6 +7,10 @@
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 #include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <stdint.h>
 
 struct Mesh;
 
@@ -16,7 +20,14 @@ namespace Shader {
 	using ProgramPtr = std::shared_ptr<Program>;
 
 	GLuint Build(const GLchar* vsCode, const GLchar* fsCode);
-	GLuint BuildFromFile(const char* vsPath, const char* fsPath);
+	GLuint BuildFromFile(const char* vsPath, const char* fsPath, const char* defines = nullptr);
+	GLuint BuildCompute(const GLchar* csCode);
+	GLuint BuildComputeFromFile(const char* csPath, const char* defines = nullptr);
+	GLuint BeginBuild(const GLchar* vsCode, const GLchar* fsCode);
+	bool IsBuildCompleted(GLuint program);
+	GLuint EndBuild(GLuint program);
+	std::vector<GLchar> ReadFile(const char* path);
+	std::vector<GLchar> InsertDefines(const std::vector<GLchar>& code, const char* defines);
 
 	/*
 		.
@@ -71,23 +82,28 @@ namespace Shader {
 	class Program
 	{
 	public:
-		static ProgramPtr Create(const char* vsPath, const char* fsPath);
+		static ProgramPtr Create(const char* vsPath, const char* fsPath,
+			const char* defines = nullptr);
 		explicit Program(GLuint programId);
 		~Program();
 
+		void Reset(GLuint programId);
 		void Use();
-		void BindTexture(GLuint, GLuint);
+		GLuint Id() const { return id; }
+		void BindTexture(GLuint, GLuint, GLenum target = GL_TEXTURE_2D);
 		void SetLightList(const LightList&);
 		void SetViewProjectionMatrix(const glm::mat4&);
+		void SetDepthBase(GLint);
 		// void Draw(const Mesh& mesh,
 			// const glm::vec3& translate, const glm::vec3& rotate, const glm::vec3& scale);
 
 	private:
-		GLuint id;	// vOID.
+		GLuint id = 0;	// vOID.
 
 		// uniformϐ̈ʒu.
 		GLint locMatMVP;
 		GLint locMatModel;
+		GLint locDepthBase;
 		GLint locAmbLightCol;
 		GLint locDirLightDir;
 		GLint locDirLightCol;
@@ -99,6 +115,54 @@ namespace Shader {
 
 		glm::mat4 matVP;	// r[EvWFNVs.
 		LightList lights;
+		bool hasLightList = false;	// SetLightList()Ă΂ꂽ.
+	};
+
+	/*
+		VF[_[̋@\tO.
+	*/
+	enum Feature : uint32_t
+	{
+		Feature_Textured = 0x01,	///< eNX`g(TEXTURED).
+		Feature_TextureArray = 0x02,	///< zeNX`g(TEXTURE_ARRAY).
+		Feature_Bindless = 0x04,	///< gl_DrawIDŃoChXEeNX`I(BINDLESS).
+	};
+
+	/*
+		1̃VF[_[Et@CvO̎.
+
+		@\tO#defineƂăVF[_[̐擪ɒǉ邱ƂŁA
+		gȂ@\̃R[h܂܂ȂvO.
+	*/
+	struct Permutation
+	{
+		uint32_t features = 0;	///< Feature_*̑gݍ킹.
+
+		uint32_t Key() const { return features; }
+		std::string Defines() const;
+	};
+
+	/*
+		ނƂɍ쐬vOێLbV.
+
+		t@CƎނ̑gݍ킹2ڈȍ~Ɏ擾ƁA쐬ς݂̃vOԂ.
+	*/
+	class ProgramCache
+	{
+	public:
+		static ProgramCache& Instance();
+
+		ProgramPtr Get(const char* vsPath, const char* fsPath, const Permutation&);
+		void Clear() { programs.clear(); }
+		size_t Size() const { return programs.size(); }
+
+	private:
+		ProgramCache() = default;
+		~ProgramCache() = default;
+		ProgramCache(const ProgramCache&) = delete;
+		ProgramCache& operator=(const ProgramCache&) = delete;
+
+		std::unordered_map<std::string, ProgramPtr> programs;	///< L[̓t@CƎ.
 	};
 
 }	// Shader namespace
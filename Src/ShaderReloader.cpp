@@ -0,0 +1,250 @@
+/*
+	@file ShaderReloader.cpp
+*/
+#include "ShaderReloader.h"
+#include <algorithm>
+#include <iostream>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace Shader {
+
+namespace /* unnamed */ {
+
+/*
+	t@C̍XV擾.
+
+	@param path	t@C.
+
+	@return XV. t@C݂Ȃ0.
+*/
+time_t GetModifiedTime(const std::string& path)
+{
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0) {
+		return 0;
+	}
+	return st.st_mtime;
+}
+
+/*
+	pXfBNgƃt@Cɕ.
+
+	@param path	pX.
+
+	@return fBNgƃt@C̃yA.
+*/
+std::pair<std::string, std::string> SplitPath(const std::string& path)
+{
+	const size_t n = path.find_last_of("/\\");
+	if (n == std::string::npos) {
+		return { ".", path };
+	}
+	return { path.substr(0, n), path.substr(n + 1) };
+}
+
+} // unnamed namespace
+
+/*
+	[_[擾.
+
+	@return [_[̃VOgCX^X.
+*/
+Reloader& Reloader::Instance()
+{
+	static Reloader instance;
+	return instance;
+}
+
+/*
+	RXgN^.
+*/
+Reloader::Reloader()
+{
+	// hCoɃVF[_[̃RpCpXbhg킹.
+	if (GLEW_KHR_parallel_shader_compile) {
+		glMaxShaderCompilerThreadsKHR(0xffffffff);
+	}
+#ifdef __linux__
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0) {
+		std::cerr << "[x]" << __func__ << ": inotifył܂.\n";
+	}
+#endif
+}
+
+/*
+	fXgN^.
+*/
+Reloader::~Reloader()
+{
+#ifdef __linux__
+	if (inotifyFd >= 0) {
+		close(inotifyFd);
+	}
+#endif
+}
+
+/*
+	vÕVF[_[Et@CĎ.
+
+	@param program	ĎvO.
+	@param vsPath	_VF[_[Et@C.
+	@param fsPath	tOgVF[_[Et@C.
+	@param defines	VF[_[ɒǉ#define.
+*/
+void Reloader::Watch(const ProgramPtr& program, const char* vsPath, const char* fsPath,
+	const char* defines)
+{
+	Entry e;
+	e.program = program;
+	e.vsPath = vsPath;
+	e.fsPath = fsPath;
+	if (defines) {
+		e.defines = defines;
+	}
+	e.vsTime = GetModifiedTime(e.vsPath);
+	e.fsTime = GetModifiedTime(e.fsPath);
+	entries.push_back(e);
+
+#ifdef __linux__
+	// GfB^͕ʖŕۑĂu邱Ƃ̂ŁAfBNgĎ.
+	if (inotifyFd < 0) {
+		return;
+	}
+	for (const std::string* path : { &e.vsPath, &e.fsPath }) {
+		const std::string dir = SplitPath(*path).first;
+		const auto itr = std::find_if(watchedDirs.begin(), watchedDirs.end(),
+			[&dir](const std::pair<int, std::string>& w) { return w.second == dir; });
+		if (itr != watchedDirs.end()) {
+			continue;
+		}
+		const int wd = inotify_add_watch(inotifyFd, dir.c_str(),
+			IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (wd < 0) {
+			std::cerr << "[x]" << __func__ << ": " << dir << " Ďł܂.\n";
+			continue;
+		}
+		watchedDirs.push_back({ wd, dir });
+	}
+#endif
+}
+
+/*
+	ύXꂽVF[_[蒼.
+
+	t[1Ăяo.
+*/
+void Reloader::Update()
+{
+	// jꂽvO菜.
+	for (Entry& e : entries) {
+		if (e.program.expired() && e.building) {
+			glDeleteProgram(e.building);
+			e.building = 0;
+		}
+	}
+	entries.erase(std::remove_if(entries.begin(), entries.end(),
+		[](const Entry& e) { return e.program.expired(); }), entries.end());
+
+	DetectChanges();
+	Rebuild();
+}
+
+/*
+	ύXꂽt@Co.
+*/
+void Reloader::DetectChanges()
+{
+#ifdef __linux__
+	if (inotifyFd < 0) {
+		return;
+	}
+	alignas(inotify_event) char buf[4096];
+	for (;;) {
+		const ssize_t len = read(inotifyFd, buf, sizeof(buf));
+		if (len <= 0) {
+			break;
+		}
+		for (const char* p = buf; p < buf + len; ) {
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+			p += sizeof(inotify_event) + event->len;
+			if (!event->len) {
+				continue;
+			}
+			const auto dir = std::find_if(watchedDirs.begin(), watchedDirs.end(),
+				[event](const std::pair<int, std::string>& w) { return w.first == event->wd; });
+			if (dir == watchedDirs.end()) {
+				continue;
+			}
+			const std::string name = event->name;
+			for (Entry& e : entries) {
+				for (const std::string* path : { &e.vsPath, &e.fsPath }) {
+					const auto splitted = SplitPath(*path);
+					if (splitted.first == dir->second && splitted.second == name) {
+						e.isModified = true;
+					}
+				}
+			}
+		}
+	}
+#else
+	// t[mFƕׂ̂ŁA30t[1񂾂mF.
+	if (++frameCount < 30) {
+		return;
+	}
+	frameCount = 0;
+	for (Entry& e : entries) {
+		const time_t vsTime = GetModifiedTime(e.vsPath);
+		const time_t fsTime = GetModifiedTime(e.fsPath);
+		if (vsTime != e.vsTime || fsTime != e.fsTime) {
+			e.vsTime = vsTime;
+			e.fsTime = fsTime;
+			e.isModified = true;
+		}
+	}
+#endif
+}
+
+/*
+	vO̍쐬JnÂu.
+*/
+void Reloader::Rebuild()
+{
+	for (Entry& e : entries) {
+		// 쐬ɍĂѕύXꂽꍇAÂ쐬ʂ͎gȂ.
+		if (e.isModified) {
+			e.isModified = false;
+			if (e.building) {
+				glDeleteProgram(e.building);
+			}
+			const std::vector<GLchar> vsCode =
+				InsertDefines(ReadFile(e.vsPath.c_str()), e.defines.c_str());
+			const std::vector<GLchar> fsCode =
+				InsertDefines(ReadFile(e.fsPath.c_str()), e.defines.c_str());
+			e.building = BeginBuild(vsCode.empty() ? nullptr : vsCode.data(),
+				fsCode.empty() ? nullptr : fsCode.data());
+			std::cout << "[]" << __func__ << ": " << e.vsPath << ", " << e.fsPath <<
+				" ēǂݍݒ.\n";
+			continue;
+		}
+		if (!e.building || !IsBuildCompleted(e.building)) {
+			continue;
+		}
+
+		// NɎsꍇ́AÂvOg.
+		const GLuint id = EndBuild(e.building);
+		e.building = 0;
+		if (id) {
+			e.program.lock()->Reset(id);
+			std::cout << "[]" << __func__ << ": " << e.vsPath << ", " << e.fsPath <<
+				" ēǂݍ݂܂.\n";
+		}
+	}
+}
+
+}	// namespace Shader
@@ -0,0 +1,64 @@
+/*
+	@file ShaderReloader.h
+*/
+#ifndef SHADERRELOADER_H_INCLUDED
+#define SHADERRELOADER_H_INCLUDED
+#include "Shader.h"
+#include <string>
+#include <vector>
+#include <time.h>
+
+namespace Shader {
+
+	/*
+		VF[_[Et@C̕ύXĎAvO蒼NX.
+
+		LinuxłinotifyŁAȊOł͍XV̒IȊmFŕύXo.
+		RpCƃN͌ʂ҂ɊJnA܂ł͌ÂvOg.
+		NɐꍇAUpdate()̒ŃvOu.
+
+		Update()𖈃t[Ăяo.
+	*/
+	class Reloader
+	{
+	public:
+		static Reloader& Instance();
+
+		void Watch(const ProgramPtr&, const char* vsPath, const char* fsPath,
+			const char* defines = nullptr);
+		void Update();
+
+	private:
+		Reloader();
+		~Reloader();
+		Reloader(const Reloader&) = delete;
+		Reloader& operator=(const Reloader&) = delete;
+
+		void DetectChanges();
+		void Rebuild();
+
+		// Ď̃vO.
+		struct Entry
+		{
+			std::weak_ptr<Program> program;
+			std::string vsPath;
+			std::string fsPath;
+			std::string defines;	///< VF[_[ɒǉ#define.
+			time_t vsTime = 0;		///< _VF[_[Et@C̍XV.
+			time_t fsTime = 0;		///< tOgVF[_[Et@C̍XV.
+			bool isModified = false;	///< t@CύXꂽ.
+			GLuint building = 0;	///< 쐬̃vOEIuWFNg.
+		};
+		std::vector<Entry> entries;
+
+#ifdef __linux__
+		int inotifyFd = -1;			///< inotifỹt@CLqq.
+		std::vector<std::pair<int, std::string>> watchedDirs;	///< Ď̃fBNg.
+#else
+		int frameCount = 0;			///< XVmF邽߂̃t[JE^.
+#endif
+	};
+
+}	// namespace Shader
+
+#endif // SHADERRELOADER_H_INCLUDED
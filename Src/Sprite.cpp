@@ -4,9 +4,15 @@
 */
 
 #include "Sprite.h"
+#include "SpriteBatch.h"
+#include "SpriteGrid.h"
+#include "Particle.h"
+#include "QuadIndexBuffer.h"
+#include "GpuResourceRegistry.h"
 #include <vector>
 #include <iostream>
-#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <algorithm>
 
 /*
 	SpriteRXgN^.
@@ -45,21 +51,20 @@ void Sprite::Texture(const Texture::Image2DPtr& tex)
 
 bool SpriteRenderer::Init(size_t maxSpriteCount, const char* vsPath, const char* fsPath)
 {
-	vbo.Create(GL_ARRAY_BUFFER, sizeof(Vertex) * maxSpriteCount * 4, nullptr, GL_STREAM_DRAW);
-
+	GPU_RESOURCE_SITE();
 
-	// lp`maxSpriteCount.
-	std::vector<GLushort> indices;
-	indices.resize(maxSpriteCount * 6);		// lp`ƂɃCfbNX͂UKv.(Op`2̒_)
-	for (GLushort i = 0; i < maxSpriteCount; ++i) {
-		indices[i * 6 + 0] = (i * 4) + 0;
-		indices[i * 6 + 1] = (i * 4) + 1;
-		indices[i * 6 + 2] = (i * 4) + 2;
-		indices[i * 6 + 3] = (i * 4) + 2;
-		indices[i * 6 + 4] = (i * 4) + 3;
-		indices[i * 6 + 5] = (i * 4) + 0;
+	// lp`̃CfbNX͑SĂSpriteRendererŋL.
+	// maxQuadCount𒴂镪́AQuadIndexBuffer::DrawElements()CfbNXJԂg.
+	// CfbNX쐬łȂꍇ́ACfbNX͈̔͂𒴂ĕ`悵Ȃ悤ɒ_obt@炷.
+	QuadIndexBuffer& ibo = QuadIndexBuffer::Instance();
+	const size_t requiredQuadCount = std::min(maxSpriteCount, QuadIndexBuffer::maxQuadCount);
+	const size_t quadCount = ibo.Reserve(requiredQuadCount);
+	if (quadCount < requiredQuadCount) {
+		std::cerr << "[x]" << __func__ << ": " << quadCount <<
+			"𒴂XvCg͕`ł܂.\n";
+		maxSpriteCount = quadCount;
 	}
-	ibo.Create(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+	vbo.Create(GL_ARRAY_BUFFER, sizeof(Vertex) * maxSpriteCount * 4, nullptr, GL_STREAM_DRAW);
 
 	// Vertex\̂ɍ킹Ē_Agr[gݒ.
 	vao.Create(vbo.Id(), ibo.Id());
@@ -69,10 +74,35 @@ bool SpriteRenderer::Init(size_t maxSpriteCount, const char* vsPath, const char*
 	vao.VertexAttribPointer(
 		1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, color));
 	vao.VertexAttribPointer(
-		2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, texCoord));
+		2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, texCoord));
 	vao.Unbind();
 
-	program = Shader::Program::Create(vsPath, fsPath);
+	// eNX`̗LŁAKvȋ@\vOg.
+	Shader::Permutation textured;
+	textured.features = Shader::Feature_Textured;
+	program = Shader::ProgramCache::Instance().Get(vsPath, fsPath, textured);
+	untexturedProgram = Shader::ProgramCache::Instance().Get(vsPath, fsPath, Shader::Permutation());
+	Shader::Permutation arrayTextured;
+	arrayTextured.features = Shader::Feature_Textured | Shader::Feature_TextureArray;
+	arrayProgram = Shader::ProgramCache::Instance().Get(vsPath, fsPath, arrayTextured);
+
+	// v~eBuɈ˂炸1ŕ`悷邽߁A\ȂԐڕ`ƃoChXEeNX`g.
+	// v~eBu͍őŃXvCgƓɂȂACfbNX̋؂܂т1.
+	if (GLEW_ARB_multi_draw_indirect && GLEW_ARB_bindless_texture &&
+		GLEW_ARB_shader_draw_parameters) {
+		Shader::Permutation bindless;
+		bindless.features = Shader::Feature_Textured | Shader::Feature_Bindless;
+		bindlessProgram = Shader::ProgramCache::Instance().Get(vsPath, fsPath, bindless);
+		const size_t maxCommandCount = maxSpriteCount + maxSpriteCount / QuadIndexBuffer::maxQuadCount;
+		indirectBuffer.Create(GL_DRAW_INDIRECT_BUFFER,
+			maxCommandCount * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+		handleBuffer.Create(GL_SHADER_STORAGE_BUFFER,
+			maxCommandCount * sizeof(GLuint64), nullptr, GL_STREAM_DRAW);
+		indirectCommands.reserve(maxCommandCount);
+		drawHandles.reserve(maxCommandCount);
+	}
+
+	glGenQueries(1, &samplesQuery);
 
 	primitives.reserve(64); //		32ł͑ȂƂ邩Ȃ̂64\.
 
@@ -85,6 +115,14 @@ bool SpriteRenderer::Init(size_t maxSpriteCount, const char* vsPath, const char*
 }	
 
 
+/*
+	fXgN^.
+*/
+SpriteRenderer::~SpriteRenderer()
+{
+	glDeleteQueries(1, &samplesQuery);
+}
+
 /*
 	_f[^̍쐬Jn.
 */
@@ -92,6 +130,7 @@ bool SpriteRenderer::Init(size_t maxSpriteCount, const char* vsPath, const char*
 void SpriteRenderer::BeginUpdate()
 {
 	primitives.clear();
+	worldSizes.clear();
 	vertices.clear();
 	vertices.reserve(vbo.Size() / sizeof(Vertex));
 }
@@ -107,61 +146,339 @@ void SpriteRenderer::BeginUpdate()
 
 bool SpriteRenderer::AddVertices(const Sprite& sprite)
 {
-	if (vertices.size() * sizeof(Vertex) >= static_cast<size_t>(vbo.Size())) {
-		std::cerr << "[x]" << __func__ << ": ő\𒴂Ă܂./n";
+	return AddQuad(sprite.Position(), sprite.Rotation(), sprite.Scale(),
+		sprite.Color(), sprite.Rectangle(), sprite.Texture(), sprite.Blend());
+}
+
+/*
+	XvCgob`̑SẴXvCg̒_f[^ǉ.
+
+	@param batch	_f[^̌ƂȂXvCgob`.
+
+	@retval true	ǉ.
+	@retval false	_obt@tŁAꕔ̃XvCgǉłȂ.
+*/
+bool SpriteRenderer::AddVertices(const SpriteBatch& batch)
+{
+	const std::vector<glm::vec3>& positions = batch.Positions();
+	const std::vector<float>& rotations = batch.Rotations();
+	const std::vector<glm::vec2>& scales = batch.Scales();
+	const std::vector<glm::vec4>& colors = batch.Colors();
+	const std::vector<Rect>& rects = batch.Rects();
+	const std::vector<uint16_t>& textureIndices = batch.TextureIndices();
+	const std::vector<BlendMode>& blendModes = batch.BlendModes();
+	for (size_t i = 0; i < batch.Size(); ++i) {
+		if (!AddQuad(positions[i], rotations[i], scales[i], colors[i], rects[i],
+			batch.GetTexture(textureIndices[i]), blendModes[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+	\͈͂ƏdȂXvCg̒_f[^ǉ.
+
+	@param batch	_f[^̌ƂȂXvCgob`.
+	@param grid		batch̃XvCgo^Obh.
+	@param view		\͈.
+
+	@retval true	ǉ.
+	@retval false	_obt@tŁAꕔ̃XvCgǉłȂ.
+
+	\͈͊ÕXvCg͒_f[^쐬Ȃ̂ŁA
+	ׂ̓ob`Ŝł͂Ȃ\XvCg̐ɔႷ.
+	Obȟʂ̏Ԃ̓Z̏Ԃŕς邽߁Aob`̓Y̏ɕבւĂǉ.
+	ɂAdȂXvCg̕`揇AddVertices(batch)ƓɂȂ.
+*/
+bool SpriteRenderer::AddVertices(
+	const SpriteBatch& batch, const SpriteGrid& grid, const Rect& view)
+{
+	visibleSprites.clear();
+	grid.Query(view, visibleSprites);
+	visibleIndices.clear();
+	for (const SpriteHandle& h : visibleSprites) {
+		const uint32_t index = batch.IndexOf(h);
+		if (index != SpriteBatch::invalidIndex) {
+			visibleIndices.push_back(index);
+		}
+	}
+	std::sort(visibleIndices.begin(), visibleIndices.end());
+
+	const std::vector<glm::vec3>& positions = batch.Positions();
+	const std::vector<float>& rotations = batch.Rotations();
+	const std::vector<glm::vec2>& scales = batch.Scales();
+	const std::vector<glm::vec4>& colors = batch.Colors();
+	const std::vector<Rect>& rects = batch.Rects();
+	const std::vector<uint16_t>& textureIndices = batch.TextureIndices();
+	const std::vector<BlendMode>& blendModes = batch.BlendModes();
+	for (uint32_t i : visibleIndices) {
+		if (!AddQuad(positions[i], rotations[i], scales[i], colors[i], rects[i],
+			batch.GetTexture(textureIndices[i]), blendModes[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+	p[eBNEVXȇSẴp[eBN̒_f[^ǉ.
+
+	@param particles	_f[^̌ƂȂp[eBNEVXe.
+
+	@retval true	ǉ.
+	@retval false	_obt@tŁAꕔ̃p[eBNǉłȂ.
+*/
+bool SpriteRenderer::AddVertices(const ParticleSystem& particles)
+{
+	for (const ParticleEmitterPtr& e : particles.Emitters()) {
+		if (!AddVertices(*e)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+	G~b^[̑SẴp[eBN̒_f[^ǉ.
+
+	@param emitter	_f[^̌ƂȂG~b^[.
+
+	@retval true	ǉ.
+	@retval false	_obt@tŁAꕔ̃p[eBNǉłȂ.
+
+	Init()Ŏw肵őXvCg܂ł̃p[eBN`ł.
+	QuadIndexBuffer::maxQuadCount𒴂镪́A`掞ɋ؂Ē_̊Jnʒu炷.
+	p[eBN͉]Ȃlp`Ȃ̂ŁASpriteoRɔz񂩂璼ڒ_f[^쐬.
+	G~b^[̃p[eBN͑SēeNX`ƍ@Ȃ̂ŁA1̃v~eBuɂ܂Ƃ܂.
+*/
+bool SpriteRenderer::AddVertices(const ParticleEmitter& emitter)
+{
+	const size_t maxQuadCount = static_cast<size_t>(vbo.Size()) / (sizeof(Vertex) * 4);
+	const size_t first = vertices.size() / 4;
+	const size_t quadCount =
+		std::min(emitter.Count(), maxQuadCount - std::min(first, maxQuadCount));
+	if (quadCount == 0) {
+		return emitter.Count() == 0;
+	}
+
+	const ParticleEmitterParameter& param = emitter.Parameter();
+	float layer;
+	const Texture::Image2DPtr batchTexture = BatchTexture(param.texture, layer);
+	const glm::vec2 halfSize = param.size * 0.5f;
+	const float z = param.position.z;
+	const float* posX = emitter.PositionX();
+	const float* posY = emitter.PositionY();
+	const float* colorR = emitter.ColorR();
+	const float* colorG = emitter.ColorG();
+	const float* colorB = emitter.ColorB();
+	const float* colorA = emitter.ColorA();
+	vertices.resize((first + quadCount) * 4);
+	Vertex* v = &vertices[first * 4];
+	for (size_t i = 0; i < quadCount; ++i, v += 4) {
+		const glm::vec4 color = PremultipliedColor(glm::clamp(
+			glm::vec4(colorR[i], colorG[i], colorB[i], colorA[i]), glm::vec4(0), glm::vec4(1)),
+			param.blend);
+		const float x0 = posX[i] - halfSize.x;
+		const float x1 = posX[i] + halfSize.x;
+		const float y0 = posY[i] - halfSize.y;
+		const float y1 = posY[i] + halfSize.y;
+		v[0] = { glm::vec3(x0, y0, z), color, glm::vec3(0, 0, layer) };
+		v[1] = { glm::vec3(x1, y0, z), color, glm::vec3(1, 0, layer) };
+		v[2] = { glm::vec3(x1, y1, z), color, glm::vec3(1, 1, layer) };
+		v[3] = { glm::vec3(x0, y1, z), color, glm::vec3(0, 1, layer) };
+	}
+	AddWorldSize(param.texture, std::max(param.size.x, param.size.y));
+
+	const bool isOpaque = param.blend == BlendMode::Opaque;
+	const size_t indexCount = quadCount * 6;
+	if (!primitives.empty() && primitives.back().texture == batchTexture &&
+		primitives.back().isOpaque == isOpaque) {
+		primitives.back().count += indexCount;
+	} else {
+		primitives.push_back(
+			{ indexCount, first * 6 * sizeof(GLushort), batchTexture, isOpaque });
+	}
+
+	if (quadCount < emitter.Count()) {
+		std::cerr << "[x]" << __func__ << ": ő\𒴂Ă܂.\n";
 		return false;
 	}
-	const Texture::Image2DPtr& texture = sprite.Texture();
-	const glm::vec2 reciprocalSize(
-		glm::vec2(1) / glm::vec2(texture->Width(), texture->Height()));
+	return true;
+}
+
+/*
+	XvCg1̒_f[^쐬.
+
+	@param v		_f[^̊i[(QuadCount(texture) * 4vf).
+	@param position	S̍W.
+	@param rotation	]px(WA).
+	@param scale	g嗦.
+	@param color	F.
+	@param rect		eNX`̋`(sNZP).
+	@param texture	eNX`.
+	@param layer	zeNX`̑wԍ. zeNX`gȂꍇ0.
+	@param blend	@.
+
+	_̐F͍@ɍ킹Zς݃At@Ŋi[.
+	eNX`ɓʑp`΁Ap``ɕlp`쐬ēȕ`悵Ȃ.
+*/
+void SpriteRenderer::MakeQuad(Vertex* v, const glm::vec3& position, float rotation,
+	const glm::vec2& scale, const glm::vec4& straightColor, const Rect& rect,
+	const Texture::Image2DPtr& texture, float layer, BlendMode blend)
+{
+	const glm::vec4 color = PremultipliedColor(straightColor, blend);
 
 	// `0.0`1.0͈̔͂ɕϊ.
-	Rect rect = sprite.Rectangle();
-	rect.origin *= reciprocalSize;
-	rect.size *= reciprocalSize;
+	// eNX`ȂꍇAeNX`W͎gȂ.
+	glm::vec2 texOrigin(0);
+	glm::vec2 texSize(0);
+	if (texture) {
+		const glm::vec2 reciprocalSize(
+			glm::vec2(1) / glm::vec2(texture->Width(), texture->Height()));
+		texOrigin = rect.origin * reciprocalSize;
+		texSize = rect.size * reciprocalSize;
+	}
 
 	// S̑傫vZ.
-	const glm::vec2 halfSize = sprite.Rectangle().size * 0.5f;
+	const glm::vec2 halfSize = rect.size * 0.5f * scale;
+
+	// gE]Esړsg킸ɌvZ.
+	const float c = std::cos(rotation);
+	const float s = std::sin(rotation);
+	const glm::vec3 axisX(c * halfSize.x, s * halfSize.x, 0);
+	const glm::vec3 axisY(-s * halfSize.y, c * halfSize.y, 0);
+
+	// `̈ʒu(0.0`1.0)璸_쐬.
+	const auto makeVertex = [&](Vertex& e, const glm::vec2& p) {
+		e.position = position + axisX * (p.x * 2 - 1) + axisY * (p.y * 2 - 1);
+		e.color = color;
+		e.texCoord = glm::vec3(texOrigin + texSize * p, layer);
+	};
+
+	const size_t quadCount = QuadCount(texture);
+	const bool isWholeImage = texture && rect.origin == glm::vec2(0) &&
+		rect.size == glm::vec2(texture->Width(), texture->Height());
+	if (quadCount > 1 && isWholeImage) {
+		// ʑp`̒_0𒆐SƂ`A2̎Op`Ȃlp`ɕ.
+		// _̏ꍇAŌ̎lp`2ڂ̎Op`ׂ.
+		const std::vector<glm::vec2>& outline = texture->Outline();
+		const size_t last = outline.size() - 1;
+		for (size_t i = 0; i < quadCount; ++i) {
+			makeVertex(v[i * 4 + 0], outline[0]);
+			makeVertex(v[i * 4 + 1], outline[i * 2 + 1]);
+			makeVertex(v[i * 4 + 2], outline[i * 2 + 2]);
+			makeVertex(v[i * 4 + 3], outline[std::min(i * 2 + 3, last)]);
+		}
+	} else {
+		makeVertex(v[0], glm::vec2(0, 0));
+		makeVertex(v[1], glm::vec2(1, 0));
+		makeVertex(v[2], glm::vec2(1, 1));
+		makeVertex(v[3], glm::vec2(0, 1));
 
-	// Wϊs쐬.
-	const glm::mat4 matT = glm::translate(glm::mat4(1), sprite.Position());
-	const glm::mat4 matR =
-		glm::rotate(glm::mat4(1), sprite.Rotation(), glm::vec3(0, 0, 1));
-	const glm::mat4 matS = glm::scale(glm::mat4(1), glm::vec3(sprite.Scale(), 1));
-	const glm::mat4 transform = matT * matR * matS;
+		// eNX`̈ꕔ\ꍇ͓ʑp`gȂ̂ŁAc̎lp`ׂ͒Ă.
+		for (size_t i = 4; i < quadCount * 4; ++i) {
+			v[i] = v[0];
+		}
+	}
 
-	Vertex v[4];
+	// eNX`Ŝ`悵Ƃ̑傫AXg[~OpɋL^.
+	if (texture) {
+		AddWorldSize(texture, std::max(texture->Width() * std::abs(scale.x),
+			texture->Height() * std::abs(scale.y)));
+	}
+}
 
-	v[0].position = transform * glm::vec4(-halfSize.x, -halfSize.y, 0, 1);
-	v[0].color = sprite.Color();
-	v[0].texCoord = rect.origin;
+/*
+	eNX`Ŝ`悵Ƃ̑傫L^.
+
+	@param texture	eNX`.
+	@param size		[hWł̑傫.
+
+	eNX`L^ꂽꍇ͍őlc.
+	ʏ̑傫̓J̊g嗦ŕς邽߁ADraw()ŕϊĂeNX`ɕ񍐂.
+*/
+void SpriteRenderer::AddWorldSize(const Texture::Image2DPtr& texture, float size)
+{
+	if (!texture) {
+		return;
+	}
+	float& e = worldSizes[texture];
+	e = std::max(e, size);
+}
+
+/*
+	L^傫ʏ̑傫ɕϊāAXg[~OpɃeNX`ɕ񍐂.
+
+	@param pixelsPerUnit	[hW1Pʂ߂sNZ.
+*/
+void SpriteRenderer::ReportScreenSizes(float pixelsPerUnit) const
+{
+	for (const auto& e : worldSizes) {
+		e.first->ReportScreenSize(e.second * pixelsPerUnit);
+	}
+}
+
+/*
+	XvCg1̕`Ɏglp`̐擾.
+
+	@param texture	XvCg̃eNX`.
+
+	@return eNX`ɓʑp`΁Ap`𕪊lp`̐. Ȃ1.
+*/
+size_t SpriteRenderer::QuadCount(const Texture::Image2DPtr& texture)
+{
+	if (!texture || texture->Outline().size() < 3) {
+		return 1;
+	}
+	return (texture->Outline().size() - 1) / 2;
+}
 
-	v[1].position = transform * glm::vec4(-halfSize.x, -halfSize.y, 0, 1);
-	v[1].color = sprite.Color();
-	v[1].texCoord = glm::vec2(rect.origin.x + rect.size.x, rect.origin.y);
+/*
+	XvCg1̒_f[^ǉ.
 
-	v[2].position = transform * glm::vec4(-halfSize.x, -halfSize.y, 0, 1);
-	v[2].color = sprite.Color();
-	v[2].texCoord = rect.origin + rect.size;
+	@param position	S̍W.
+	@param rotation	]px(WA).
+	@param scale	g嗦.
+	@param color	F.
+	@param rect		eNX`̋`(sNZP).
+	@param texture	eNX`.
+	@param blend	@.
 
-	v[3].position = transform * glm::vec4(-halfSize.x, -halfSize.y, 0, 1);
-	v[3].color = sprite.Color();
-	v[3].texCoord = glm::vec2(rect.origin.x, rect.origin.y + rect.size.y);
+	@retval true	ǉ.
+	@retval false	_obt@tŒǉłȂ.
+*/
+bool SpriteRenderer::AddQuad(const glm::vec3& position, float rotation,
+	const glm::vec2& scale, const glm::vec4& color, const Rect& rect,
+	const Texture::Image2DPtr& texture, BlendMode blend)
+{
+	const size_t quadCount = QuadCount(texture);
+	if ((vertices.size() + quadCount * 4) * sizeof(Vertex) > static_cast<size_t>(vbo.Size())) {
+		std::cerr << "[x]" << __func__ << ": ő\𒴂Ă܂./n";
+		return false;
+	}
 
-	vertices.insert(vertices.end(), v, v + 4);
+	float layer;
+	const Texture::Image2DPtr batchTexture = BatchTexture(texture, layer);
+	const size_t first = vertices.size();
+	vertices.resize(first + quadCount * 4);
+	MakeQuad(&vertices[first], position, rotation, scale, color, rect, texture, layer, blend);
+	const size_t indexCount = quadCount * 6;
 
+	const bool isOpaque = blend == BlendMode::Opaque;
 	if (primitives.empty()) {
 		// ŏ̃v~eBu쐬B
-		primitives.push_back({ 6, 0, texture });
+		primitives.push_back({ indexCount, 0, batchTexture, isOpaque });
 	} else {
-		// eNX`gĂȂCfbNXlp`1(CfbNX6)₷.
-		// eNX`Ⴄꍇ͐Vv~eBu쐬.
+		// eNX`ƕ`pXȂCfbNXlp`̐(1ɂCfbNX6)₷.
+		// Ⴄꍇ͐Vv~eBu쐬.
+		// Zς݃At@Ȃ̂ŁAƉZ͓v~eBuɂ܂Ƃ߂.
 		Primitive& data = primitives.back();
-		if (data.texture == texture) {
-			data.count += 6;
+		if (data.texture == batchTexture && data.isOpaque == isOpaque) {
+			data.count += indexCount;
 		} else {
-			primitives.push_back(
-				{ 6, data.offset + data.count * sizeof(GLushort), texture });
+			primitives.push_back({ indexCount, data.offset + data.count * sizeof(GLushort),
+				batchTexture, isOpaque });
 		}
 	}
 
@@ -178,35 +495,523 @@ void SpriteRenderer::EndUpdate()
 	vertices.shrink_to_fit();
 }
 
+/*
+	ێ[hŒ_f[^XV.
+
+	@param batch	_f[^̌ƂȂXvCgob`.
+
+	@retval true	XV.
+	@retval false	_obt@tŁAꕔ̃XvCg\łȂ.
+
+	XvCg̒_f[^̓ob`̓YƓʒuɕێA
+	ǑĂяoύXꂽXvCgvZē].
+	ύX̗L̓ob`̕ύXԍŒׂ邽߁Aob`̏Ԃ͏Ȃ.
+	߂ɂύXӏ͂܂Ƃ߂1œ].
+	BeginUpdate()/AddVertices()/EndUpdate()Ƃ͕płȂ.
+*/
+bool SpriteRenderer::UpdateVertices(const SpriteBatch& batch)
+{
+	const size_t maxQuadCount = static_cast<size_t>(vbo.Size()) / (sizeof(Vertex) * 4);
+	const std::vector<uint16_t>& textureIndices = batch.TextureIndices();
+	const std::vector<BlendMode>& blendModes = batch.BlendModes();
+
+	// ʂ̃ob`ɐ؂ւꍇ́ASĂ̒_f[^蒼.
+	const bool isNewBatch = retainedBatch != &batch;
+	retainedBatch = &batch;
+
+	// XvCg̒ǉ폜ꍇ́AXvCgƂ̎lp`̈ʒuƃv~eBu蒼.
+	// XvCg̎lp`̐̓eNX`Ō܂邽߁A폜ɂւeNX`̕ύX
+	// r̃XvCg̎lp`̐ςƁAȍ~̃XvCg̈ʒu.
+	// ʒuςXvCǵAύXĂȂĂ_f[^蒼.
+	std::vector<uint32_t> previousFirstQuads;
+	if (isNewBatch || retainedVersion != batch.StructureVersion()) {
+		retainedVersion = batch.StructureVersion();
+		previousFirstQuads.swap(retainedFirstQuads);
+		primitives.clear();
+		worldSizes.clear();
+		retainedFirstQuads.assign(1, 0);
+		for (size_t i = 0; i < batch.Size(); ++i) {
+			const Texture::Image2DPtr& original = batch.GetTexture(textureIndices[i]);
+			const size_t first = retainedFirstQuads.back();
+			const size_t quadCount = QuadCount(original);
+			if (first + quadCount > maxQuadCount) {
+				break;
+			}
+			retainedFirstQuads.push_back(static_cast<uint32_t>(first + quadCount));
+			if (original) {
+				AddWorldSize(original, std::max(original->Width() * std::abs(batch.Scales()[i].x),
+					original->Height() * std::abs(batch.Scales()[i].y)));
+			}
+
+			float layer;
+			const Texture::Image2DPtr texture = BatchTexture(original, layer);
+			const bool isOpaque = blendModes[i] == BlendMode::Opaque;
+			if (primitives.empty() || primitives.back().texture != texture ||
+				primitives.back().isOpaque != isOpaque) {
+				primitives.push_back(
+					{ 0, first * 6 * sizeof(GLushort), texture, isOpaque });
+			}
+			primitives.back().count += quadCount * 6;
+		}
+	}
+	const size_t spriteCount = retainedFirstQuads.size() - 1;
+	retainedVertices.resize(retainedFirstQuads.back() * 4);
+	const auto isMoved = [this, &previousFirstQuads](size_t i) {
+		return !previousFirstQuads.empty() && (i + 1 >= previousFirstQuads.size() ||
+			previousFirstQuads[i] != retainedFirstQuads[i] ||
+			previousFirstQuads[i + 1] != retainedFirstQuads[i + 1]);
+	};
+
+	const std::vector<glm::vec3>& positions = batch.Positions();
+	const std::vector<float>& rotations = batch.Rotations();
+	const std::vector<glm::vec2>& scales = batch.Scales();
+	const std::vector<glm::vec4>& colors = batch.Colors();
+	const std::vector<Rect>& rects = batch.Rects();
+	const std::vector<uint32_t>& changeVersions = batch.ChangeVersions();
+
+	// ύXꂽXvCg̒_f[^vZAA͈͂Ƃɓ].
+	// Ԋu͈͂́A]񐔂炷߂1ɂ܂Ƃ߂. ͈͎͂lp`P.
+	static const size_t mergeDistance = 8;	// ̐ȉ̊ԊuȂ͈͂܂Ƃ߂.
+	size_t rangeBegin = 0;
+	size_t rangeEnd = 0;
+	const auto flush = [this, &rangeBegin, &rangeEnd]() {
+		if (rangeBegin < rangeEnd) {
+			vbo.BufferSubData(rangeBegin * 4 * sizeof(Vertex),
+				(rangeEnd - rangeBegin) * 4 * sizeof(Vertex), &retainedVertices[rangeBegin * 4]);
+		}
+	};
+	for (size_t i = 0; i < spriteCount; ++i) {
+		if (!isNewBatch && changeVersions[i] <= retainedChangeVersion && !isMoved(i)) {
+			continue;
+		}
+		const Texture::Image2DPtr& texture = batch.GetTexture(textureIndices[i]);
+		float layer;
+		BatchTexture(texture, layer);
+		const size_t first = retainedFirstQuads[i];
+		const size_t last = retainedFirstQuads[i + 1];
+		MakeQuad(&retainedVertices[first * 4], positions[i], rotations[i], scales[i], colors[i],
+			rects[i], texture, layer, blendModes[i]);
+		if (rangeBegin < rangeEnd && first - rangeEnd <= mergeDistance) {
+			rangeEnd = last;
+		} else {
+			flush();
+			rangeBegin = first;
+			rangeEnd = last;
+		}
+	}
+	flush();
+	retainedChangeVersion = batch.ChangeVersion();
+
+	if (batch.Size() > spriteCount) {
+		std::cerr << "[x]" << __func__ << ": ő\𒴂Ă܂.\n";
+		return false;
+	}
+	return true;
+}
+
+/*
+	ʃTCYr[EvWFNVs擾.
+
+	@param screenSize	ʃTCY.
+
+	@return _ʂ̒SƂ镽sẽr[EvWFNVs.
+
+	ʃTCYOƓꍇ́AOvZsԂ.
+*/
+const glm::mat4& SpriteRenderer::ScreenViewProjectionMatrix(const glm::vec2& screenSize) const
+{
+	if (screenSize != screenCamera.size) {
+		screenCamera.size = screenSize;
+		screenCamera.camera.Viewport(0, 0,
+			static_cast<GLsizei>(screenSize.x), static_cast<GLsizei>(screenSize.y));
+	}
+	return screenCamera.camera.ViewProjectionMatrix();
+}
+
 /*
 	@param texture		`ɎgpeNX`.
 	@param screenSize	ʃTCY.
 */
 void SpriteRenderer::Draw(const glm::vec2& screenSize) const
 {
-	glDisable(GL_DEPTH_TEST);
+	ReportScreenSizes(1);
+	Draw(ScreenViewProjectionMatrix(screenSize));
+}
+
+/*
+	J猩XvCg`悷.
+
+	@param camera	`ɎgpJ.
+
+	r[|[g̓J̐ݒɕύX.
+*/
+void SpriteRenderer::Draw(const Camera2D& camera) const
+{
+	camera.ApplyViewport();
+	ReportScreenSizes(camera.Zoom());
+	Draw(camera.ViewProjectionMatrix());
+}
+
+/*
+	XvCg`悷.
+
+	@param matVP	`Ɏgpr[EvWFNVs.
+
+	sȃv~eBuɁA[x݂ȂO珇ɕ`悷.
+	ĔƉZ̃v~eBuA[xeXgLɂĒǉɕ`悷.
+	[x͒_̕яVF[_[ō邽߁A`挋ʂ͒ǉɏd˂ꍇƕς炸A
+	sȃXvCgɉBsNZ͓hȂȂ.
+*/
+void SpriteRenderer::Draw(const glm::mat4& matVP) const
+{
+	UpdateOverdraw();
+	blendChangeCount = 0;
+	if (primitives.empty()) {
+		return;
+	}
+
+	// ÕNǦʂ󂯎Ă΁A̕`̃sNZ𐔂.
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	const bool beginQuery = samplesQuery && !isQueryPending;
+	if (beginQuery) {
+		queryViewportArea = viewport[2] * viewport[3];
+		glBeginQuery(GL_SAMPLES_PASSED, samplesQuery);
+	}
+
+	const bool hasOpaque = std::any_of(primitives.begin(), primitives.end(),
+		[](const Primitive& e) { return e.isOpaque; });
+	if (hasOpaque) {
+		// [x̓r[|[g͈̔͂.
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(viewport[0], viewport[1], viewport[2], viewport[3]);
+		glDepthMask(GL_TRUE);
+		glClear(GL_DEPTH_BUFFER_BIT);
+		glDisable(GL_SCISSOR_TEST);
+
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LESS);
+		glDisable(GL_BLEND);
+		++blendChangeCount;
+		DrawPrimitives(matVP, true);
+		glDepthMask(GL_FALSE);
+	} else {
+		glDisable(GL_DEPTH_TEST);
+	}
+
+	// ƉŹAZς݃At@ɂ1̍ݒŕ`ł.
 	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	++blendChangeCount;
+	if (!DrawIndirect(matVP)) {
+		DrawPrimitives(matVP, false);
+	}
+
+	if (hasOpaque) {
+		glDepthMask(GL_TRUE);
+		glDisable(GL_DEPTH_TEST);
+	}
+	if (beginQuery) {
+		glEndQuery(GL_SAMPLES_PASSED);
+		isQueryPending = true;
+	}
+}
 
+/*
+	̕`pX̃v~eBu`悷.
+
+	@param matVP	`Ɏgpr[EvWFNVs.
+	@param isOpaque	trueȂsȃv~eButɁAfalseȂcǉɕ`悷.
+*/
+void SpriteRenderer::DrawPrimitives(const glm::mat4& matVP, bool isOpaque) const
+{
 	vao.Bind();
-	program->Use();
+	const Shader::Program* current = nullptr;
+	GLenum target = GL_TEXTURE_2D;
+	for (size_t i = 0; i < primitives.size(); ++i) {
+		// sȃv~eBu͎O(ォǉ)`悵āÃsNZ[xeXgŎ̂Ă.
+		const Primitive& primitive = primitives[isOpaque ? primitives.size() - 1 - i : i];
+		if (primitive.isOpaque != isOpaque) {
+			continue;
+		}
+		const Shader::ProgramPtr& p = ProgramFor(primitive.texture);
+		if (p.get() != current) {
+			current = p.get();
+			p->Use();
+			p->SetViewProjectionMatrix(matVP);
+			p->SetDepthBase(0);
+		}
+		if (primitive.texture) {
+			primitive.texture->MarkUsed();
+			target = primitive.texture->Target();
+			p->BindTexture(0, primitive.texture->Get(), target);
+		}
+		QuadIndexBuffer::DrawElements(static_cast<GLsizei>(primitive.count), primitive.offset);
+	}
+	if (current) {
+		program->BindTexture(0, 0, target);
+	}
+	vao.Unbind();
+}
 
-	// seA_͉ʂ̒S.
-	const glm::vec2 halfScreenSize = screenSize * 0.5f;
-	const glm::mat4x4 matProj = glm::ortho(
-		-halfScreenSize.x, halfScreenSize.x, -halfScreenSize.y, halfScreenSize.y,
-		1.0f, 1000.0f);
-	const glm::mat4x4 matView = glm::lookAt(
-		glm::vec3(0, 0, 100), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
-	program->SetViewProjectionMatrix(matProj * matView);
+/*
+	`悵sNZ̃NǦʂ󂯎AI[o[h[XV.
 
+	ʂ͂܂GPU҂Ȃ悤ɁA܂ȂΑO̒l̂܂܂ɂ.
+*/
+void SpriteRenderer::UpdateOverdraw() const
+{
+	if (!isQueryPending) {
+		return;
+	}
+	GLint available = 0;
+	glGetQueryObjectiv(samplesQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) {
+		return;
+	}
+	GLuint64 samples = 0;
+	glGetQueryObjectui64v(samplesQuery, GL_QUERY_RESULT, &samples);
+	isQueryPending = false;
+	if (queryViewportArea > 0) {
+		overdraw = static_cast<float>(samples) / static_cast<float>(queryViewportArea);
+	}
+}
+
+/*
+	SẴv~eBu1̊Ԑڕ`ŕ`悷.
+
+	@param matVP	`Ɏgpr[EvWFNVs.
+
+	@retval true	`悵.
+	@retval false	Ԑڕ`ɑΉĂȂA܂͔zeNX`gv~eBu.
+
+	sȃv~eBu͕`悵Ȃ. Draw()ɕ`pX𕪂ĕ`悵Ă.
+
+	v~eBuƂ̕`R}hƃeNX`Enhobt@ɏ݁A
+	glMultiDrawElementsIndirectŕ`悷. VF[_[gl_DrawIDŃnhI.
+*/
+bool SpriteRenderer::DrawIndirect(const glm::mat4& matVP) const
+{
+	if (!bindlessProgram || !bindlessProgram->Id()) {
+		return false;
+	}
 	for (const Primitive& primitive : primitives) {
-		program->BindTexture(0, primitive.texture->Get());
-		glDrawElements(GL_TRIANGLES, primitive.count, GL_UNSIGNED_SHORT,
-			reinterpret_cast<const GLvoid*>(primitive.offset));
+		if (primitive.texture && primitive.texture->Target() != GL_TEXTURE_2D) {
+			return false;
+		}
+	}
+
+	// jꂽeNX`̃nh菜. nh̓eNX`ƈꏏɖɂȂ.
+	for (auto itr = textureHandles.begin(); itr != textureHandles.end();) {
+		if (itr->second.texture.expired()) {
+			itr = textureHandles.erase(itr);
+		} else {
+			++itr;
+		}
 	}
-	program->BindTexture(0, 0);
+
+	indirectCommands.clear();
+	drawHandles.clear();
+	for (const Primitive& primitive : primitives) {
+		if (primitive.isOpaque) {
+			continue;
+		}
+		// CfbNX̋؂܂v~eBúAQuadIndexBuffer::DrawElements()Ɠ
+		// ؂育Ƃ̃R}hɕ. eNX`Enh͂ǂ̃R}h.
+		const GLuint64 handle = TextureHandle(primitive.texture);
+		size_t quad = primitive.offset / (6 * sizeof(GLushort));
+		size_t remaining = primitive.count / 6;
+		while (remaining > 0) {
+			const size_t chunk = quad / QuadIndexBuffer::maxQuadCount;
+			const size_t local = quad - chunk * QuadIndexBuffer::maxQuadCount;
+			const size_t n = std::min(remaining, QuadIndexBuffer::maxQuadCount - local);
+			DrawElementsIndirectCommand cmd;
+			cmd.count = static_cast<GLuint>(n * 6);
+			cmd.instanceCount = 1;
+			cmd.firstIndex = static_cast<GLuint>(local * 6);
+			cmd.baseVertex = static_cast<GLint>(chunk * QuadIndexBuffer::maxQuadCount * 4);
+			cmd.baseInstance = 0;
+			indirectCommands.push_back(cmd);
+			drawHandles.push_back(handle);
+			quad += n;
+			remaining -= n;
+		}
+	}
+	indirectBuffer.BufferSubData(0,
+		indirectCommands.size() * sizeof(DrawElementsIndirectCommand), indirectCommands.data());
+	if (indirectCommands.empty()) {
+		return true;
+	}
+	handleBuffer.BufferSubData(0, drawHandles.size() * sizeof(GLuint64), drawHandles.data());
+
+	vao.Bind();
+	bindlessProgram->Use();
+	bindlessProgram->SetViewProjectionMatrix(matVP);
+	bindlessProgram->SetDepthBase(0);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, handleBuffer.Id());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer.Id());
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, nullptr,
+		static_cast<GLsizei>(indirectCommands.size()), 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
 	vao.Unbind();
+	return true;
+}
+
+/*
+	eNX`̏풓ς݃nh擾.
+
+	@param texture	nh擾eNX`.
+
+	@return eNX`Enh. texturenullptrȂ0.
+
+	쐬nh́AeNX`j邩eNX`EIuWFNgu܂ōėp.
+	폜ꂽID͍ėp̂ŁAIDł͂ȂŒuo.
+*/
+GLuint64 SpriteRenderer::TextureHandle(const Texture::Image2DPtr& texture) const
+{
+	if (!texture || !texture->Get()) {
+		return 0;
+	}
+	texture->MarkUsed();
+	TextureHandleEntry& e = textureHandles[texture.get()];
+	if (e.texture.lock() != texture || e.generation != texture->Generation()) {
+		e.texture = texture;
+		e.generation = texture->Generation();
+		e.handle = glGetTextureHandleARB(texture->Get());
+		glMakeTextureHandleResidentARB(e.handle);
+	}
+	return e.handle;
+}
+
+/*
+	v~eBu̕`ɎgvO擾.
+
+	@param texture	v~eBũeNX`.
+
+	@return eNX`̎ނɍvO.
+*/
+const Shader::ProgramPtr& SpriteRenderer::ProgramFor(const Texture::Image2DPtr& texture) const
+{
+	if (!texture) {
+		return untexturedProgram;
+	}
+	return texture->Target() == GL_TEXTURE_2D_ARRAY ? arrayProgram : program;
+}
+
+/*
+	`掞ɃoCheNX`擾.
+
+	@param texture	XvCg̃eNX`.
+	@param layer	zeNX`̑wԍi[ϐ.
+
+	@return texturezeNX`Ɋi[ĂΔzeNX`AȂtexture.
+*/
+Texture::Image2DPtr SpriteRenderer::BatchTexture(
+	const Texture::Image2DPtr& texture, float& layer) const
+{
+	layer = 0;
+	if (textureArray && texture) {
+		const int n = textureArray->FindLayer(texture.get());
+		if (n >= 0) {
+			layer = static_cast<float>(n);
+			return textureArray;
+		}
+	}
+	return texture;
+}
+
+/*
+	XvCg̃eNX`uzeNX`ݒ肷.
+
+	@param p	zeNX`. nullptrȂzeNX`gȂ.
+
+	pɊi[ꂽeNX`gXvCǵAeNX`Ă1̕`ɂ܂Ƃ߂.
+	i[ĂȂeNX`́A܂ŒʂʂɃoCh.
+*/
+void SpriteRenderer::TextureArray(const Texture::ImageArray2DPtr& p)
+{
+	textureArray = p;
+
+	// ێ[h̒_f[^ƃv~eBu蒼.
+	retainedBatch = nullptr;
+}
+
+/*
+	`R}h쐬.
+
+	@param buffer		R}hǉobt@.
+	@param screenSize	ʃTCY.
+	@param layer		`惌C[.
+
+	ɂ͕`悹ARenderCommandBuffer::Execute()łق̕`Ƃ܂Ƃ߂Ďs.
+*/
+void SpriteRenderer::Draw(
+	RenderCommandBuffer& buffer, const glm::vec2& screenSize, uint8_t layer) const
+{
+	ReportScreenSizes(1);
+	AddCommands(buffer, buffer.AddView(ScreenViewProjectionMatrix(screenSize)), layer);
+}
+
+/*
+	J猩XvCg̕`R}h쐬.
+
+	@param buffer	R}hǉobt@.
+	@param camera	`ɎgpJ.
+	@param layer	`惌C[.
+
+	قȂJŕĂяoƁA_f[^𕡐̃r[|[gɕ`ł.
+*/
+void SpriteRenderer::Draw(
+	RenderCommandBuffer& buffer, const Camera2D& camera, uint8_t layer) const
+{
+	// J̊g嗦́A[hW1Pʂr[|[gŐ߂sNZɂȂ.
+	ReportScreenSizes(camera.Zoom());
+	AddCommands(buffer,
+		buffer.AddView(camera.ViewProjectionMatrix(), camera.Viewport()), layer);
+}
+
+/*
+	v~eBuƂ̕`R}hǉ.
+
+	@param buffer	R}hǉobt@.
+	@param view		RenderCommandBuffer::AddView()Ŏ擾r[ԍ.
+	@param layer	`惌C[.
+*/
+void SpriteRenderer::AddCommands(
+	RenderCommandBuffer& buffer, uint16_t view, uint8_t layer) const
+{
+	// _̕я[xƂĎgAԂ̃v~eBȕԂۂ.
+	// ق̕`Ɛ[xdȂȂ悤ɁAC[͈̔͂mۂĔԍ炷.
+	size_t quadCount = 0;
+	for (const Primitive& primitive : primitives) {
+		quadCount = std::max(quadCount, (primitive.offset / sizeof(GLushort) + primitive.count) / 6);
+	}
+	const GLint depthBase = buffer.AllocateDepth(layer, quadCount);
+	for (const Primitive& primitive : primitives) {
+		GLuint texture = 0;
+		if (primitive.texture) {
+			primitive.texture->MarkUsed();
+			texture = primitive.texture->Get();
+		}
+		const Shader::ProgramPtr& p = ProgramFor(primitive.texture);
+		RenderCommand command;
+		if (primitive.texture) {
+			command.textureTarget = primitive.texture->Target();
+		}
+		command.sortKey = RenderCommandBuffer::MakeSortKey(layer, p->Id(), texture,
+			static_cast<uint32_t>(depthBase + primitive.offset / (6 * sizeof(GLushort))),
+			!primitive.isOpaque);
+		command.program = p.get();
+		command.vao = vao.Id();
+		command.texture = texture;
+		command.count = static_cast<GLsizei>(primitive.count);
+		command.offset = primitive.offset;
+		command.blend = !primitive.isOpaque;
+		command.view = view;
+		command.depthBase = depthBase;
+		buffer.Add(command);
+	}
 }
 
 /*
@@ -215,5 +1020,6 @@ void SpriteRenderer::Draw(const glm::vec2& screenSize) const
 void SpriteRenderer::Clear()
 {
 	primitives.clear();
+	worldSizes.clear();
 }
 
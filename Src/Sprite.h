@@ -8,18 +8,54 @@
 #include "BufferObject.h"
 #include "Texture.h"
 #include "Shader.h"
+#include "RenderCommandBuffer.h"
+#include "Geometry.h"
+#include "Camera2D.h"
 #include <glm/glm.hpp>
 #include <vector>
+#include <unordered_map>
+#include <stdint.h>
 
 /*
-	`\.
+	SpriteBatch̃XvCgʂnh.
+
+	XvCg̒ǉ폜Ŕz̈ʒuςĂAXvCgw.
 */
-struct Rect
+struct SpriteHandle
 {
-	glm::vec2 origin;	///< _.
-	glm::vec2 size;		///< c̕.
+	uint32_t slot = UINT32_MAX;	///< Xbgԍ.
+	uint32_t generation = 0;	///< Xbg̐. 폜ƕω.
 };
 
+/*
+	XvCg̍@.
+
+	`͏Zς݃At@ōs߁AAlphaAdditive͓ݒ1̕`ɂ܂Ƃ߂.
+*/
+enum class BlendMode : uint8_t
+{
+	Alpha,		///< At@lɂ锼.
+	Additive,	///< Z.
+	Opaque,		///< s. ɏ㏑.
+};
+
+/*
+	FZς݃At@ɕϊ.
+
+	@param color	F.
+	@param mode		@.
+
+	@return Zς݃At@̐F. Zł̓At@0ɂāAwic܂ܑ킹.
+*/
+inline glm::vec4 PremultipliedColor(const glm::vec4& color, BlendMode mode)
+{
+	switch (mode) {
+	case BlendMode::Additive: return glm::vec4(glm::vec3(color) * color.w, 0);
+	case BlendMode::Opaque: return glm::vec4(glm::vec3(color), 1);
+	default: return glm::vec4(glm::vec3(color) * color.w, color.w);
+	}
+}
+
 /*
 	XvCgNX.
 */
@@ -56,6 +92,10 @@ public:
 	void Texture(const Texture::Image2DPtr& tex);
 	const Texture::Image2DPtr& Texture() const { return texture; }
 
+	// @̐ݒE擾
+	void Blend(BlendMode m) { blendMode = m; }
+	BlendMode Blend() const { return blendMode; }
+
 private:
 	glm::vec3 position = glm::vec3(0);
 	glm::f32 rotation = 0;
@@ -63,36 +103,103 @@ private:
 	glm::vec4 color = glm::vec4(1);
 	Rect rect = { glm::vec2(0, 0), glm::vec2(1, 1) };
 	Texture::Image2DPtr texture;
+	BlendMode blendMode = BlendMode::Alpha;
 };
 
+class SpriteBatch;
+class SpriteGrid;
+class ParticleSystem;
+class ParticleEmitter;
+
 /*
 	XvCg`NX.
+
+	CfbNX16rbgȂ̂ŁAQuadIndexBuffer::maxQuadCount(16384)𒴂lp`
+	؂Ē_̊Jnʒu炵ĕ`悷. Init()Ŏw肵܂ŕ`ł.
 */
 class SpriteRenderer
 {
 public:
 	SpriteRenderer() = default;
-	~SpriteRenderer() = default;
+	~SpriteRenderer();
 	SpriteRenderer(const SpriteRenderer&) = delete;
 	SpriteRenderer& operator=(const SpriteRenderer&) = delete;
 
 	bool Init(size_t maxSpriteCount, const char* vsPath, const char* fsPath);
 	void BeginUpdate();
 	bool AddVertices(const Sprite&);
+	bool AddVertices(const SpriteBatch&);
+	bool AddVertices(const SpriteBatch&, const SpriteGrid&, const Rect& view);
+	bool AddVertices(const ParticleSystem&);
+	bool AddVertices(const ParticleEmitter&);
 	void EndUpdate();
+	bool UpdateVertices(const SpriteBatch&);
 	void Draw(const glm::vec2&) const;
+	void Draw(const Camera2D&) const;
+	void Draw(RenderCommandBuffer&, const glm::vec2&, uint8_t layer) const;
+	void Draw(RenderCommandBuffer&, const Camera2D&, uint8_t layer) const;
 	void Clear();
 
+	void TextureArray(const Texture::ImageArray2DPtr&);
+	const Texture::ImageArray2DPtr& TextureArray() const { return textureArray; }
+
+	// ODraw()̓v.
+	size_t BlendChangeCount() const { return blendChangeCount; }
+	float Overdraw() const { return overdraw; }
+
 private:
+	struct Vertex;
+	void MakeQuad(Vertex* v, const glm::vec3& position, float rotation,
+		const glm::vec2& scale, const glm::vec4& color, const Rect& rect,
+		const Texture::Image2DPtr& texture, float layer, BlendMode blend);
+	static size_t QuadCount(const Texture::Image2DPtr&);
+	Texture::Image2DPtr BatchTexture(const Texture::Image2DPtr&, float& layer) const;
+	void AddWorldSize(const Texture::Image2DPtr&, float);
+	void ReportScreenSizes(float pixelsPerUnit) const;
+	bool AddQuad(const glm::vec3& position, float rotation, const glm::vec2& scale,
+		const glm::vec4& color, const Rect& rect, const Texture::Image2DPtr& texture,
+		BlendMode blend);
+	const Shader::ProgramPtr& ProgramFor(const Texture::Image2DPtr&) const;
+	void Draw(const glm::mat4&) const;
+	void DrawPrimitives(const glm::mat4&, bool isOpaque) const;
+	bool DrawIndirect(const glm::mat4&) const;
+	void UpdateOverdraw() const;
+	GLuint64 TextureHandle(const Texture::Image2DPtr&) const;
+	void AddCommands(RenderCommandBuffer&, uint16_t view, uint8_t layer) const;
+	const glm::mat4& ScreenViewProjectionMatrix(const glm::vec2& screenSize) const;
+
 	BufferObject vbo;
-	BufferObject ibo;
 	VertexArrayObject vao;
-	Shader::ProgramPtr program;
+	Shader::ProgramPtr program;				///< eNX`tXvCgp.
+	Shader::ProgramPtr untexturedProgram;	///< eNX`ȂXvCgp.
+	Shader::ProgramPtr arrayProgram;		///< zeNX`Ɋi[XvCgp.
+	Texture::ImageArray2DPtr textureArray;	///< eNX`uzeNX`.
+
+	// Ԑڕ`̏.
+	// v~eBuƂ̃eNX`gl_DrawIDőIԂ̂ŁASẴv~eBu1ŕ`ł.
+	struct DrawElementsIndirectCommand {
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+	struct TextureHandleEntry {
+		std::weak_ptr<Texture::Image2D> texture;
+		uint32_t generation;	///< nh쐬Ƃ̃eNX`̐.
+		GLuint64 handle;	///< 풓ς݂̃eNX`Enh.
+	};
+	Shader::ProgramPtr bindlessProgram;	///< Ԑڕ`p. ΉȂnullptr.
+	mutable BufferObject indirectBuffer;	///< `R}h.
+	mutable BufferObject handleBuffer;		///< `R}hƂ̃eNX`Enh.
+	mutable std::vector<DrawElementsIndirectCommand> indirectCommands;
+	mutable std::vector<GLuint64> drawHandles;
+	mutable std::unordered_map<const Texture::Image2D*, TextureHandleEntry> textureHandles;
 
 	struct Vertex {
 		glm::vec3 position;	///< W.
 		glm::vec4 color;	///< F.
-		glm::vec2 texCoord;	///< eNX`W.
+		glm::vec3 texCoord;	///< eNX`W(z͔zeNX`̑wԍ).
 	};
 	std::vector<Vertex> vertices;	// _f[^z.
 
@@ -100,8 +207,32 @@ private:
 		size_t count;
 		size_t offset;
 		Texture::Image2DPtr texture;
+		bool isOpaque;	///< spXŕ`悷邩.
 	};
 	std::vector<Primitive> primitives;
+	std::unordered_map<Texture::Image2DPtr, float> worldSizes;	///< eNX`Ŝ`悵Ƃ̑傫([hW).
+	std::vector<SpriteHandle> visibleSprites;	///< ̍Ɨpz.
+	std::vector<uint32_t> visibleIndices;		///< XvCg̃ob`̓Y.
+
+	// ʃTCYw肵ĕ`悷Ƃ̃J.
+	mutable struct {
+		glm::vec2 size = glm::vec2(0);
+		Camera2D camera;
+	} screenCamera;
+
+	// ێ[h̏.
+	std::vector<Vertex> retainedVertices;		///< VBOƓe̒_f[^.
+	std::vector<uint32_t> retainedFirstQuads;	///< XvCgƂ̍ŏ̎lp`̔ԍ(͑).
+	const SpriteBatch* retainedBatch = nullptr;	///< ŌUpdateVertices()ob`.
+	uint32_t retainedVersion = 0;				///< Ōɔfob`̍\ԍ.
+	uint32_t retainedChangeVersion = 0;			///< Ōɔfob`̕ύXԍ.
+
+	// v.
+	mutable size_t blendChangeCount = 0;	///< ݒ؂ւ.
+	mutable float overdraw = 0;				///< `悵sNZr[|[g̃sNZ.
+	mutable GLuint samplesQuery = 0;		///< `悵sNZ𐔂NG.
+	mutable bool isQueryPending = false;	///< NǦʂ҂Ă邩.
+	mutable GLint queryViewportArea = 0;	///< NGJñr[|[g̃sNZ.
 };
 
 #endif		// SPRITE_H_INCLUDED
\ No newline at end of file
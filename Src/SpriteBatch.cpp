@@ -0,0 +1,233 @@
+/*
+	@file SpriteBatch.cpp
+*/
+#include "SpriteBatch.h"
+#include <iostream>
+
+const Sprite SpriteBatch::invalidSprite;
+
+/*
+	i[̈\񂷂.
+
+	@param n	\񂷂XvCg.
+*/
+void SpriteBatch::Reserve(size_t n)
+{
+	positions.reserve(n);
+	rotations.reserve(n);
+	scales.reserve(n);
+	colors.reserve(n);
+	rects.reserve(n);
+	textureIndices.reserve(n);
+	blendModes.reserve(n);
+	changeVersions.reserve(n);
+	indexToSlot.reserve(n);
+	slotToIndex.reserve(n);
+	generations.reserve(n);
+}
+
+/*
+	XvCgǉ.
+
+	@param sprite	ǉXvCg.
+
+	@return ǉXvCg̃nh.
+*/
+SpriteHandle SpriteBatch::Add(const Sprite& sprite)
+{
+	uint32_t slot;
+	if (freeSlots.empty()) {
+		slot = static_cast<uint32_t>(slotToIndex.size());
+		slotToIndex.push_back(0);
+		generations.push_back(0);
+	} else {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	const uint32_t index = static_cast<uint32_t>(positions.size());
+	slotToIndex[slot] = index;
+	indexToSlot.push_back(slot);
+
+	positions.push_back(sprite.Position());
+	rotations.push_back(sprite.Rotation());
+	scales.push_back(sprite.Scale());
+	colors.push_back(sprite.Color());
+	rects.push_back(sprite.Rectangle());
+	textureIndices.push_back(AddTexture(sprite.Texture()));
+	blendModes.push_back(sprite.Blend());
+	changeVersions.push_back(++changeVersion);
+	++structureVersion;
+
+	return { slot, generations[slot] };
+}
+
+/*
+	XvCg폜.
+
+	@param h	폜XvCg̃nh.
+
+	@retval true	폜.
+	@retval false	nh.
+
+	̃XvCg폜ʒuɈړ̂ŁAق̃XvCg̓Yς邱Ƃ.
+*/
+bool SpriteBatch::Remove(SpriteHandle h)
+{
+	if (!IsValid(h)) {
+		return false;
+	}
+	const uint32_t index = slotToIndex[h.slot];
+	const uint32_t last = static_cast<uint32_t>(positions.size() - 1);
+	if (index != last) {
+		positions[index] = positions[last];
+		rotations[index] = rotations[last];
+		scales[index] = scales[last];
+		colors[index] = colors[last];
+		rects[index] = rects[last];
+		textureIndices[index] = textureIndices[last];
+		blendModes[index] = blendModes[last];
+		MarkChanged(index);
+		indexToSlot[index] = indexToSlot[last];
+		slotToIndex[indexToSlot[index]] = index;
+	}
+	positions.pop_back();
+	rotations.pop_back();
+	scales.pop_back();
+	colors.pop_back();
+	rects.pop_back();
+	textureIndices.pop_back();
+	blendModes.pop_back();
+	changeVersions.pop_back();
+	indexToSlot.pop_back();
+
+	++generations[h.slot];
+	freeSlots.push_back(h.slot);
+	++structureVersion;
+	return true;
+}
+
+/*
+	nhLׂ.
+
+	@param h	ׂnh.
+
+	@retval true	L.
+	@retval false	(폜ς݁A܂͕ʂ̃ob`̃nh).
+*/
+bool SpriteBatch::IsValid(SpriteHandle h) const
+{
+	return h.slot < generations.size() && generations[h.slot] == h.generation &&
+		slotToIndex[h.slot] < positions.size() && indexToSlot[slotToIndex[h.slot]] == h.slot;
+}
+
+/*
+	ȃnhgꂽƂ񍐂.
+
+	@param h	ȃnh.
+
+	@return false.
+
+	폜ς݂̃nhŕʂ̃XvCgύXA͈͊Oǂݏ肵Ȃ悤ɁA
+	eANZT͂̊֐falseԂ牽Ȃ.
+*/
+bool SpriteBatch::ReportInvalidHandle(SpriteHandle h) const
+{
+	std::cerr << "[x]" << __func__ << ": ȃnhł(slot=" << h.slot <<
+		", generation=" << h.generation << ").\n";
+	return false;
+}
+
+/*
+	z̓Ynh擾.
+
+	@param index	z̓Y(0`Size()-1).
+
+	@return ŸʒuɂXvCg̃nh.
+*/
+SpriteHandle SpriteBatch::HandleAt(size_t index) const
+{
+	const uint32_t slot = indexToSlot[index];
+	return { slot, generations[slot] };
+}
+
+/*
+	SẴXvCg폜.
+
+	폜OɎ擾nh͑SĖɂȂ.
+*/
+void SpriteBatch::Clear()
+{
+	for (uint32_t slot : indexToSlot) {
+		++generations[slot];
+		freeSlots.push_back(slot);
+	}
+	positions.clear();
+	rotations.clear();
+	scales.clear();
+	colors.clear();
+	rects.clear();
+	textureIndices.clear();
+	blendModes.clear();
+	changeVersions.clear();
+	indexToSlot.clear();
+	++structureVersion;
+}
+
+/*
+	eNX`o^.
+
+	@param tex	o^eNX`.
+
+	@return eNX`ԍ. o^ς݂̏ꍇ͂̔ԍԂ.
+*/
+uint16_t SpriteBatch::AddTexture(const Texture::Image2DPtr& tex)
+{
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (textures[i] == tex) {
+			return static_cast<uint16_t>(i);
+		}
+	}
+	textures.push_back(tex);
+	return static_cast<uint16_t>(textures.size() - 1);
+}
+
+/*
+	XvCg̃eNX`ݒ肷.
+
+	@param h	XvCg̃nh.
+	@param tex	ݒ肷eNX`.
+
+	Sprite::Texture()ƓlɁA`̓eNX`Ŝɐݒ肳.
+*/
+void SpriteBatch::Texture(SpriteHandle h, const Texture::Image2DPtr& tex)
+{
+	if (!Check(h)) {
+		return;
+	}
+	const uint32_t index = Index(h);
+	textureIndices[index] = AddTexture(tex);
+	rects[index] = Rect{ glm::vec2(0), glm::vec2(tex->Width(), tex->Height()) };
+	MarkChanged(index);
+	++structureVersion;
+}
+
+/*
+	XvCg̍@ύX.
+
+	@param h	ύXXvCg̃nh.
+	@param m	@.
+
+	sƔ؂ւƃv~eBu̕ς邽߁A\ԍXV.
+*/
+void SpriteBatch::Blend(SpriteHandle h, BlendMode m)
+{
+	if (!Check(h)) {
+		return;
+	}
+	const uint32_t index = Index(h);
+	if ((blendModes[index] == BlendMode::Opaque) != (m == BlendMode::Opaque)) {
+		++structureVersion;
+	}
+	blendModes[index] = m;
+	MarkChanged(index);
+}
@@ -0,0 +1,103 @@
+/*
+	@file SpriteBatch.h
+*/
+#ifndef SPRITEBATCH_H_INCLUDED
+#define SPRITEBATCH_H_INCLUDED
+#include "Sprite.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+/*
+	̃XvCgvfƂ̔zɕĊi[NX.
+
+	WFȂǂʁX̘AzɊi[邱ƂŁA
+	_f[^̍쐬ɕKvȃf[^Ԃɓǂݏo悤ɂĂ.
+	폜͖̗vfƂ̓ւōs߁Az̏Ԃ͕ۑȂ.
+*/
+class SpriteBatch
+{
+public:
+	SpriteBatch() = default;
+	~SpriteBatch() = default;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	void Reserve(size_t);
+	SpriteHandle Add(const Sprite&);
+	bool Remove(SpriteHandle);
+	bool IsValid(SpriteHandle) const;
+	SpriteHandle HandleAt(size_t index) const;
+	uint32_t IndexOf(SpriteHandle h) const { return IsValid(h) ? Index(h) : invalidIndex; }
+	void Clear();
+	size_t Size() const { return positions.size(); }
+
+	uint16_t AddTexture(const Texture::Image2DPtr&);
+	const Texture::Image2DPtr& GetTexture(uint16_t index) const { return textures[index]; }
+
+	// vf̐ݒE擾.
+	// ȃnh̏ꍇAݒ͉A擾͊l̃XvCg̒lԂ.
+	void Position(SpriteHandle h, const glm::vec3& p) { if (Check(h)) { positions[Index(h)] = p; MarkChanged(Index(h)); } }
+	const glm::vec3& Position(SpriteHandle h) const { return Check(h) ? positions[Index(h)] : invalidSprite.Position(); }
+	void Rotation(SpriteHandle h, float r) { if (Check(h)) { rotations[Index(h)] = r; MarkChanged(Index(h)); } }
+	float Rotation(SpriteHandle h) const { return Check(h) ? rotations[Index(h)] : invalidSprite.Rotation(); }
+	void Scale(SpriteHandle h, const glm::vec2& s) { if (Check(h)) { scales[Index(h)] = s; MarkChanged(Index(h)); } }
+	const glm::vec2& Scale(SpriteHandle h) const { return Check(h) ? scales[Index(h)] : invalidSprite.Scale(); }
+	void Color(SpriteHandle h, const glm::vec4& c) { if (Check(h)) { colors[Index(h)] = c; MarkChanged(Index(h)); } }
+	const glm::vec4& Color(SpriteHandle h) const { return Check(h) ? colors[Index(h)] : invalidSprite.Color(); }
+	void Rectangle(SpriteHandle h, const Rect& r) { if (Check(h)) { rects[Index(h)] = r; MarkChanged(Index(h)); } }
+	const Rect& Rectangle(SpriteHandle h) const { return Check(h) ? rects[Index(h)] : invalidSprite.Rectangle(); }
+	void Texture(SpriteHandle h, const Texture::Image2DPtr& tex);
+	uint16_t TextureIndex(SpriteHandle h) const { return Check(h) ? textureIndices[Index(h)] : invalidTextureIndex; }
+	void Blend(SpriteHandle h, BlendMode m);
+	BlendMode Blend(SpriteHandle h) const { return Check(h) ? blendModes[Index(h)] : invalidSprite.Blend(); }
+
+	static const uint16_t invalidTextureIndex = UINT16_MAX;	///< ȃnh̃eNX`ԍ.
+	static const uint32_t invalidIndex = UINT32_MAX;		///< ȃnh̔z̓Y.
+
+	// zւ̒ڃANZX. Y0`Size()-1.
+	const std::vector<glm::vec3>& Positions() const { return positions; }
+	const std::vector<float>& Rotations() const { return rotations; }
+	const std::vector<glm::vec2>& Scales() const { return scales; }
+	const std::vector<glm::vec4>& Colors() const { return colors; }
+	const std::vector<Rect>& Rects() const { return rects; }
+	const std::vector<uint16_t>& TextureIndices() const { return textureIndices; }
+	const std::vector<BlendMode>& BlendModes() const { return blendModes; }
+	const std::vector<uint32_t>& ChangeVersions() const { return changeVersions; }
+
+	// XvCg̗vfύX邽тɑԍ.
+	// p鑤͔fς݂̔ԍoĂAChangeVersions()̒l傫XvCgXV.
+	uint32_t ChangeVersion() const { return changeVersion; }
+
+	// ǉA폜AeNX`⍇@̕ύX邽тɕωԍ.
+	uint32_t StructureVersion() const { return structureVersion; }
+
+private:
+	bool Check(SpriteHandle h) const { return IsValid(h) || ReportInvalidHandle(h); }
+	bool ReportInvalidHandle(SpriteHandle) const;
+	uint32_t Index(SpriteHandle h) const { return slotToIndex[h.slot]; }
+	void MarkChanged(uint32_t index) { changeVersions[index] = ++changeVersion; }
+
+	// XvCg̗vfƂ̔z.
+	std::vector<glm::vec3> positions;
+	std::vector<float> rotations;
+	std::vector<glm::vec2> scales;
+	std::vector<glm::vec4> colors;
+	std::vector<Rect> rects;
+	std::vector<uint16_t> textureIndices;
+	std::vector<BlendMode> blendModes;
+	std::vector<uint32_t> changeVersions;	///< ŌɕύXꂽƂ̕ύXԍ.
+	std::vector<uint32_t> indexToSlot;	///< z̓YXbgԍւ̑Ή\.
+
+	// nh̊Ǘ.
+	std::vector<uint32_t> slotToIndex;	///< Xbgԍz̓Yւ̑Ή\.
+	std::vector<uint32_t> generations;	///< XbgƂ̐.
+	std::vector<uint32_t> freeSlots;	///< gp̃Xbgԍ.
+
+	static const Sprite invalidSprite;	///< ȃnhŎ擾ƂɕԂl.
+	std::vector<Texture::Image2DPtr> textures;	///< gpeNX`̈ꗗ.
+	uint32_t structureVersion = 0;
+	uint32_t changeVersion = 0;
+};
+
+#endif // SPRITEBATCH_H_INCLUDED
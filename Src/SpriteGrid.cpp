@@ -0,0 +1,233 @@
+/*
+	@file SpriteGrid.cpp
+*/
+#include "SpriteGrid.h"
+#include <cmath>
+
+/*
+	RXgN^.
+
+	@param cellSize	Z̈ӂ̒. ʓIȃXvCg菭傫lKĂ.
+*/
+SpriteGrid::SpriteGrid(float cellSize) :
+	cellSize(cellSize), reciprocalCellSize(1.0f / cellSize)
+{
+}
+
+/*
+	W܂ރZ̎ʔԍ擾.
+
+	@param p	W.
+
+	@return Z̎ʔԍ.
+*/
+uint64_t SpriteGrid::CellKey(const glm::vec2& p) const
+{
+	const int32_t x = static_cast<int32_t>(std::floor(p.x * reciprocalCellSize));
+	const int32_t y = static_cast<int32_t>(std::floor(p.y * reciprocalCellSize));
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+/*
+	XvCgo^.
+
+	@param h		XvCg̃nh.
+	@param center	XvCg̒SW.
+	@param radius	XvCg͂މ~̔a.
+*/
+void SpriteGrid::Insert(SpriteHandle h, const glm::vec2& center, float radius)
+{
+	if (h.slot >= entries.size()) {
+		entries.resize(h.slot + 1);
+	}
+	Entry& e = entries[h.slot];
+	if (e.isInserted) {
+		RemoveFromCell(h.slot);
+	} else {
+		++count;
+	}
+	std::vector<SpriteHandle>& cell = cells[CellKey(center)];
+	e.isInserted = true;
+	e.generation = h.generation;
+	e.cellKey = CellKey(center);
+	e.indexInCell = static_cast<uint32_t>(cell.size());
+	e.center = center;
+	e.radius = radius;
+	cell.push_back(h);
+	if (radius > maxRadius) {
+		maxRadius = radius;
+	}
+}
+
+/*
+	XvCg̈ʒuXV.
+
+	@param h		XvCg̃nh.
+	@param center	XvCg̒SW.
+	@param radius	XvCg͂މ~̔a.
+
+	Z̒ňړꍇ́AZ̓o^ύXȂ.
+*/
+void SpriteGrid::Move(SpriteHandle h, const glm::vec2& center, float radius)
+{
+	if (!Contains(h)) {
+		Insert(h, center, radius);
+		return;
+	}
+	Entry& e = entries[h.slot];
+	if (CellKey(center) != e.cellKey) {
+		Insert(h, center, radius);
+		return;
+	}
+	e.center = center;
+	e.radius = radius;
+	if (radius > maxRadius) {
+		maxRadius = radius;
+	}
+}
+
+/*
+	XvCg̓o^.
+
+	@param h	XvCg̃nh.
+
+	SpriteBatch::Remove()ŃXvCg폜Ƃ́Å֐Ăяo.
+*/
+void SpriteGrid::Remove(SpriteHandle h)
+{
+	if (!Contains(h)) {
+		return;
+	}
+	RemoveFromCell(h.slot);
+	entries[h.slot].isInserted = false;
+	--count;
+}
+
+/*
+	XvCgo^Ă邩ׂ.
+
+	@param h	XvCg̃nh.
+
+	@retval true	o^Ă.
+	@retval false	o^ĂȂ.
+*/
+bool SpriteGrid::Contains(SpriteHandle h) const
+{
+	return h.slot < entries.size() && entries[h.slot].isInserted &&
+		entries[h.slot].generation == h.generation;
+}
+
+/*
+	ZXvCg菜.
+
+	@param slot	菜XvCg̃Xbgԍ.
+
+	̗vf菜ʒuɈړ.
+*/
+void SpriteGrid::RemoveFromCell(uint32_t slot)
+{
+	const Entry& e = entries[slot];
+	auto itr = cells.find(e.cellKey);
+	std::vector<SpriteHandle>& cell = itr->second;
+	if (e.indexInCell + 1 < cell.size()) {
+		cell[e.indexInCell] = cell.back();
+		entries[cell[e.indexInCell].slot].indexInCell = e.indexInCell;
+	}
+	cell.pop_back();
+	if (cell.empty()) {
+		cells.erase(itr);
+	}
+}
+
+/*
+	XvCgob`ŕύXꂽXvCg𔽉f.
+
+	@param batch	fXvCgob`.
+
+	ǑĂяoȍ~ɕύXꂽXvCgXV.
+	ύX̗L̓ob`̕ύXԍŒׂ̂ŁASpriteRenderer::UpdateVertices()Ƃ̏Ԃ͖Ȃ.
+*/
+void SpriteGrid::Sync(const SpriteBatch& batch)
+{
+	const std::vector<glm::vec3>& positions = batch.Positions();
+	const std::vector<glm::vec2>& scales = batch.Scales();
+	const std::vector<Rect>& rects = batch.Rects();
+	const std::vector<uint32_t>& changeVersions = batch.ChangeVersions();
+	const bool isNewBatch = syncedBatch != &batch;
+	for (size_t i = 0; i < batch.Size(); ++i) {
+		if (!isNewBatch && changeVersions[i] <= syncedVersion) {
+			continue;
+		}
+		const glm::vec2 halfSize = rects[i].size * 0.5f * glm::abs(scales[i]);
+		Move(batch.HandleAt(i), glm::vec2(positions[i].x, positions[i].y), glm::length(halfSize));
+	}
+	syncedBatch = &batch;
+	syncedVersion = batch.ChangeVersion();
+}
+
+/*
+	SĂ̓o^.
+*/
+void SpriteGrid::Clear()
+{
+	entries.clear();
+	cells.clear();
+	maxRadius = 0;
+	count = 0;
+	syncedBatch = nullptr;
+}
+
+/*
+	`ƏdȂ\̂XvCg.
+
+	@param view		`(ʏ͉ʂɕ\͈).
+	@param result	XvCg̃nhǉz.
+
+	@return XvCg̐.
+*/
+size_t SpriteGrid::Query(const Rect& view, std::vector<SpriteHandle>& result) const
+{
+	const size_t prevSize = result.size();
+	const glm::vec2 viewMin = view.origin;
+	const glm::vec2 viewMax = view.origin + view.size;
+
+	// Z̊Oɂ͂ݏoĂXvCg邽߁Aő唼aLĒׂ.
+	const glm::vec2 margin(maxRadius);
+	const int32_t x0 = static_cast<int32_t>(std::floor((viewMin.x - margin.x) * reciprocalCellSize));
+	const int32_t y0 = static_cast<int32_t>(std::floor((viewMin.y - margin.y) * reciprocalCellSize));
+	const int32_t x1 = static_cast<int32_t>(std::floor((viewMax.x + margin.x) * reciprocalCellSize));
+	const int32_t y1 = static_cast<int32_t>(std::floor((viewMax.y + margin.y) * reciprocalCellSize));
+
+	// ͈͓̃Zo^ς݂̃Z葽ꍇ́Ao^ς݂̃ZSĒׂق.
+	const uint64_t cellCount = static_cast<uint64_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+	const auto test = [&](const std::vector<SpriteHandle>& cell) {
+		for (const SpriteHandle& h : cell) {
+			const Entry& e = entries[h.slot];
+			if (e.center.x + e.radius >= viewMin.x && e.center.x - e.radius <= viewMax.x &&
+				e.center.y + e.radius >= viewMin.y && e.center.y - e.radius <= viewMax.y) {
+				result.push_back(h);
+			}
+		}
+	};
+	if (cellCount > cells.size()) {
+		for (const auto& e : cells) {
+			const int32_t x = static_cast<int32_t>(e.first >> 32);
+			const int32_t y = static_cast<int32_t>(e.first & 0xffffffff);
+			if (x >= x0 && x <= x1 && y >= y0 && y <= y1) {
+				test(e.second);
+			}
+		}
+	} else {
+		for (int32_t y = y0; y <= y1; ++y) {
+			for (int32_t x = x0; x <= x1; ++x) {
+				const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+					static_cast<uint32_t>(y);
+				const auto itr = cells.find(key);
+				if (itr != cells.end()) {
+					test(itr->second);
+				}
+			}
+		}
+	}
+	return result.size() - prevSize;
+}
@@ -0,0 +1,60 @@
+/*
+	@file SpriteGrid.h
+*/
+#ifndef SPRITEGRID_H_INCLUDED
+#define SPRITEGRID_H_INCLUDED
+#include "SpriteBatch.h"
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+/*
+	XvCg̉邽߂̈lObh.
+
+	XvCg͒SW܂܂Zɓo^([YEObh).
+	͈͓͂o^ς݃XvCg̍ő唼aLĒׂ̂ŁAZ܂XvCgƂȂ.
+	ړXvCg̓Zςꍇo^.
+*/
+class SpriteGrid
+{
+public:
+	explicit SpriteGrid(float cellSize = 256.0f);
+	~SpriteGrid() = default;
+	SpriteGrid(const SpriteGrid&) = delete;
+	SpriteGrid& operator=(const SpriteGrid&) = delete;
+
+	void Insert(SpriteHandle, const glm::vec2& center, float radius);
+	void Move(SpriteHandle, const glm::vec2& center, float radius);
+	void Remove(SpriteHandle);
+	bool Contains(SpriteHandle) const;
+	void Sync(const SpriteBatch&);
+	void Clear();
+	size_t Query(const Rect& view, std::vector<SpriteHandle>& result) const;
+	size_t Size() const { return count; }
+
+private:
+	uint64_t CellKey(const glm::vec2&) const;
+	void RemoveFromCell(uint32_t slot);
+
+	// XbgƂ̓o^.
+	struct Entry {
+		bool isInserted = false;
+		uint32_t generation = 0;
+		uint64_t cellKey = 0;
+		uint32_t indexInCell = 0;
+		glm::vec2 center;
+		float radius = 0;
+	};
+
+	float cellSize;
+	float reciprocalCellSize;
+	float maxRadius = 0;	///< o^ꂽXvCg̍ő唼a.
+	size_t count = 0;		///< o^ĂXvCg.
+	std::vector<Entry> entries;	///< Xbgԍňo^.
+	std::unordered_map<uint64_t, std::vector<SpriteHandle>> cells;
+	const SpriteBatch* syncedBatch = nullptr;	///< ŌSync()ob`.
+	uint32_t syncedVersion = 0;					///< Ōɔfob`̕ύXԍ.
+};
+
+#endif // SPRITEGRID_H_INCLUDED
@@ -2,6 +2,9 @@
 	@file Texture.cpp
 */
 #include "Texture.h"
+#include "TextureOutline.h"
+#include "GpuResourceRegistry.h"
+#include "GLDebug.h"
 #include <stdint.h>
 #include <vector>
 #include <fstream>
@@ -11,29 +14,26 @@
 namespace Texture {
 
 /*
-	2D eNX`쐬.
+	e2DeNX`쐬.
 
 	@param width	eNX`̕(sNZ).
 	@param height	eNX`̍(sNZ).
-	@param data		eNX`f[^ւ̃|C^.
-	@param format	]摜̃f[^`.
+	@param format	œ]摜̃f[^`.
 
 	@retval 0 ȊO	쐬eNX`EIuWFNgID.
 	@retval 0		eNX`̍쐬Ɏs.
+
+	摜f[^glTexSubImage2DŌォ].
 */
-	GLuint CreateImage2D(GLsizei width, GLsizei height, const GLvoid* data,
-		GLenum format, GLenum type)
+	GLuint CreateImageStorage2D(GLsizei width, GLsizei height, GLenum format)
 	{
+		GL_CALL_SITE();
 		GLuint id;
 		glGenTextures(1, &id);
 		glBindTexture(GL_TEXTURE_2D, id);
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-		glTexImage2D(GL_TEXTURE_2D,
-			0, GL_RGBA8, width, height, 0, format, type, data);
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-		const GLenum result = glGetError();
-		if (result != GL_NO_ERROR) {
-			std::cerr << "ERROR: eNX`̍쐬Ɏs(0x" << std::hex << result << ").";
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+		if (!GL_CALL_SUCCEEDED()) {
+			std::cerr << "ERROR: eNX`̍쐬Ɏs.\n";
 			glBindTexture(GL_TEXTURE_2D, 0);
 			glDeleteTextures(1, &id);
 			return 0;
@@ -54,24 +54,79 @@ namespace Texture {
 
 		glBindTexture(GL_TEXTURE_2D, 0);
 
+		GpuResourceRegistry::Instance().Register(GpuResourceType::Texture, id,
+			static_cast<size_t>(width) * height * 4, "Texture::CreateImageStorage2D");
+		return id;
+	}
+
+/*
+	2D eNX`쐬.
+
+	@param width	eNX`̕(sNZ).
+	@param height	eNX`̍(sNZ).
+	@param data		eNX`f[^ւ̃|C^.
+	@param format	]摜̃f[^`.
+
+	@retval 0 ȊO	쐬eNX`EIuWFNgID.
+	@retval 0		eNX`̍쐬Ɏs.
+
+	f[^͂̏œ]̂ŁA傫ȉ摜ł̓hCo҂.
+	Q[ɓǂݍޏꍇ́At[ɕē]StreamingImage2Dg.
+*/
+	GLuint CreateImage2D(GLsizei width, GLsizei height, const GLvoid* data,
+		GLenum format, GLenum type)
+	{
+		GL_CALL_SITE();
+		const GLuint id = CreateImageStorage2D(width, height, format);
+		if (!id) {
+			return 0;
+		}
+		glBindTexture(GL_TEXTURE_2D, id);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, data);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindTexture(GL_TEXTURE_2D, 0);
 
 		return id;
 	}
 
 	/*
-		t@C2DeNX`ǂݍ.
+		摜f[^2DeNX`쐬.
 
-		@param path 2DeNX`Ƃēǂݍރt@C.
+		@param image	eNX`ɂ摜f[^.
 
-		@retval 0ȊO 쐬eNX`EIuWFNgID.
-				0	  eNX`̍쐬Ɏs.
+		@retval 0 ȊO	쐬eNX`EIuWFNgID.
+		@retval 0		eNX`̍쐬Ɏs.
 	*/
+	GLuint CreateImage2D(const ImageData& image)
+	{
+		if (image.data.empty()) {
+			return 0;
+		}
+		return CreateImage2D(image.width, image.height, image.data.data(),
+			image.format, image.type);
+	}
 
-	GLuint LoadImage2D(const char* path)
+	/*
+		t@C摜f[^ǂݍ.
+
+		@param path		摜t@C.
+		@param image	ǂݍ񂾃f[^i[ϐ.
+
+		@retval true	ǂݍݐ.
+		@retval false	ǂݍݎs.
+
+		OpenGL̊֐gȂ̂ŁAʃXbhĂяoƂł.
+	*/
+	bool LoadImageData(const char* path, ImageData& image)
 	{
 		// TGAwb_ǂݍ.
 		std::basic_ifstream<uint8_t> ifs;
 		ifs.open(path, std::ios_base::binary);
+		if (!ifs.is_open()) {
+			std::cerr << "ERROR: " << path << " J܂.\n";
+			return false;
+		}
 
 		// ǂݍ݂.
 		std::vector<uint8_t> readBuffer(1'000'000);
@@ -124,8 +179,30 @@ namespace Texture {
 		} else if (tgaHeader[16] == 16) { 
 			type = GL_UNSIGNED_SHORT_1_5_5_5_REV;
 		}
-		return CreateImage2D(width, height, buf.data(), format, type);
+		image.width = width;
+		image.height = height;
+		image.format = format;
+		image.type = type;
+		image.data.swap(buf);
+		return true;
+	}
+
+	/*
+		t@C2DeNX`ǂݍ.
 
+		@param path 2DeNX`Ƃēǂݍރt@C.
+
+		@retval 0ȊO 쐬eNX`EIuWFNgID.
+				0	  eNX`̍쐬Ɏs.
+	*/
+
+	GLuint LoadImage2D(const char* path)
+	{
+		ImageData image;
+		if (!LoadImageData(path, image)) {
+			return 0;
+		}
+		return CreateImage2D(image);
 	}
 
 
@@ -144,6 +221,7 @@ namespace Texture {
 	*/
 	Image2D::~Image2D()
 	{
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Texture, id);
 		glDeleteTextures(1, &id);
 	}
 
@@ -154,8 +232,10 @@ namespace Texture {
 	*/
 	void Image2D::Reset(GLuint texId)
 	{
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Texture, id);
 		glDeleteTextures(1, &id);
 		id = texId;
+		++generation;
 		if (id)
 		{
 			// eNX`̕ƍ擾.
@@ -196,7 +276,122 @@ namespace Texture {
 	*/
 	Image2DPtr Image2D::Create(const char* path)
 	{
-		return std::make_shared<Image2D>(LoadImage2D(path));
+		ImageData image;
+		LoadImageData(path, image);
+		return Create(image);
+	}
+
+	/*
+		摜f[^2DeNX`쐬.
+
+		@param image	eNX`ɂ摜f[^.
+
+		@return	쐬eNX`IuWFNg.
+
+		At@̂摜ȂAXvCg̕`͈͂炷߂̓ʑp`쐬.
+	*/
+	Image2DPtr Image2D::Create(const ImageData& image)
+	{
+		const Image2DPtr p = std::make_shared<Image2D>(CreateImage2D(image));
+		BuildConvexOutline(image, p->outline);
+		return p;
+	}
+
+	/*
+		zeNX`쐬.
+
+		@param width		w̕(sNZ).
+		@param height		w̍(sNZ).
+		@param layerCount	w̐.
+
+		@return	쐬zeNX`.
+	*/
+	ImageArray2DPtr ImageArray2D::Create(GLsizei width, GLsizei height, GLsizei layerCount)
+	{
+		GL_CALL_SITE();
+		ImageArray2DPtr p = std::make_shared<ImageArray2D>();
+		glGenTextures(1, &p->id);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, p->id);
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, width, height, layerCount);
+		if (!GL_CALL_SUCCEEDED()) {
+			std::cerr << "ERROR: zeNX`̍쐬Ɏs.\n";
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+			glDeleteTextures(1, &p->id);
+			p->id = 0;
+			return p;
+		}
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		GpuResourceRegistry::Instance().Register(GpuResourceType::Texture, p->id,
+			static_cast<size_t>(width) * height * layerCount * 4, "Texture::ImageArray2D::Create");
+		p->width = width;
+		p->height = height;
+		p->layerCount = layerCount;
+		return p;
+	}
+
+	/*
+		2DeNX`wɃRs[.
+
+		@param image	Rs[eNX`.
+
+		@retval 0ȏ	Rs[̑wԍ.
+		@retval -1		傫ႤA`ȂA܂͋󂫑wȂ.
+
+		Rs[GPUōs. ǉ̃eNX`͔jĂ܂ȂA
+		jꍇFindLayer()ŌȂȂ.
+	*/
+	int ImageArray2D::Add(const Image2DPtr& image)
+	{
+		if (!id || !image || !image->Get()) {
+			return -1;
+		}
+		const int existing = FindLayer(image.get());
+		if (existing >= 0) {
+			return existing;
+		}
+		if (UsedLayerCount() >= layerCount) {
+			return -1;
+		}
+
+		// ~bv}bvĂeNX`GL_RED`̃eNX`́Â܂܃Rs[łȂ.
+		GLint w = 0, h = 0, swizzleG = GL_GREEN;
+		glBindTexture(GL_TEXTURE_2D, image->Get());
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+		glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, &swizzleG);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		if (w != width || h != height || swizzleG != GL_GREEN) {
+			return -1;
+		}
+
+		const int layer = UsedLayerCount();
+		glCopyImageSubData(image->Get(), GL_TEXTURE_2D, 0, 0, 0, 0,
+			id, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1);
+		layers.push_back(image);
+		layerMap[image.get()] = layer;
+		return layer;
+	}
+
+	/*
+		eNX`i[wT.
+
+		@param image	TeNX`.
+
+		@retval 0ȏ	eNX`i[wԍ.
+		@retval -1		i[ĂȂ.
+	*/
+	int ImageArray2D::FindLayer(const Image2D* image) const
+	{
+		const auto itr = layerMap.find(image);
+		if (itr == layerMap.end() || layers[itr->second].expired()) {
+			return -1;
+		}
+		return itr->second;
 	}
 
 }	// namespace Texture
\ No newline at end of file
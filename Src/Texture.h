@@ -5,35 +5,101 @@
 #ifndef TEXTURE_H_INCLUDED
 #define TEXTURE_H_INCLUDED
 #include <GL/glew.h>
+#include <glm/vec2.hpp>
 #include <memory>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
 
 namespace Texture{
 
 	class Image2D;
 	using Image2DPtr = std::shared_ptr<Image2D>;
+	class ImageArray2D;
+	using ImageArray2DPtr = std::shared_ptr<ImageArray2D>;
 
+	/*
+		t@Cǂݍ񂾉摜f[^.
+	*/
+	struct ImageData
+	{
+		GLsizei width = 0;		///< (sNZ).
+		GLsizei height = 0;		///< (sNZ).
+		GLenum format = GL_BGRA;	///< f[^`.
+		GLenum type = GL_UNSIGNED_BYTE;	///< vf̌^.
+		std::vector<uint8_t> data;	///< 摜f[^.
+	};
+
+	GLuint CreateImageStorage2D(GLsizei width, GLsizei height, GLenum format);
 	GLuint CreateImage2D(GLsizei width, GLsizei height, const GLvoid* data,
 		GLenum format, GLenum type);
+	GLuint CreateImage2D(const ImageData&);
+	bool LoadImageData(const char* path, ImageData&);
 	GLuint LoadImage2D(const char* path);
 
 	class Image2D
 	{
 	public:
 		static Image2DPtr Create(const char*);
+		static Image2DPtr Create(const ImageData&);
 		Image2D() = default;
 		explicit Image2D(GLuint);
-		~Image2D();
+		virtual ~Image2D();
 
 		void Reset(GLuint texId);
 		bool IsNull() const;
 		GLint Width() const { return width; }
 		GLint Height() const { return height; }
 		GLuint Get() const;
+		virtual GLenum Target() const { return GL_TEXTURE_2D; }
 
-	private:
+		// eNX`EIuWFNgu邽тɑԍ.
+		// 폜ꂽID͍ėp̂ŁAIDł͂Ȃ̔ԍŒuo.
+		uint32_t Generation() const { return generation; }
+
+		// `摤ÃeNX`ʏŕKvƂ𑜓x񍐂.
+		void ReportScreenSize(float size) { if (size > screenSize) { screenSize = size; } }
+		void MarkUsed() { isUsed = true; }
+
+		// sȕ͂ޓʑp`(ṽeNX`W). Ȃ`Ŝ`悷.
+		void Outline(const std::vector<glm::vec2>& v) { outline = v; }
+		const std::vector<glm::vec2>& Outline() const { return outline; }
+
+	protected:
 		GLuint id = 0;
+		uint32_t generation = 0;	///< eNX`EIuWFNg̐.
 		GLint width = 0;
 		GLint height = 0;
+		float screenSize = 0;	///< 񍐂ꂽ𑜓x̍ől(sNZ).
+		bool isUsed = false;	///< `Ɏgꂽ.
+		std::vector<glm::vec2> outline;	///< sȕ͂ޓʑp`.
+	};
+
+	/*
+		傫2DeNX`wƂĊi[zeNX`.
+
+		قȂeNX`gXvCgAeNX`؂ւɕ`悷邽߂Ɏg.
+	*/
+	class ImageArray2D : public Image2D
+	{
+	public:
+		static ImageArray2DPtr Create(GLsizei width, GLsizei height, GLsizei layerCount);
+		ImageArray2D() = default;
+		virtual ~ImageArray2D() = default;
+
+		virtual GLenum Target() const override { return GL_TEXTURE_2D_ARRAY; }
+		int Add(const Image2DPtr&);
+		int FindLayer(const Image2D*) const;
+		GLsizei LayerCount() const { return layerCount; }
+		GLsizei UsedLayerCount() const { return static_cast<GLsizei>(layers.size()); }
+
+	private:
+		GLsizei layerCount = 0;	///< i[łw̐.
+
+		// wɊi[eNX`.
+		// AhXɍꂽʂ̃eNX`Ƌʂ邽߁Aweak_ptrێ.
+		std::vector<std::weak_ptr<Image2D>> layers;
+		std::unordered_map<const Image2D*, int> layerMap;	///< eNX`wԍ.
 	};
 
 }	// namespace
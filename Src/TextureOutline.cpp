@@ -0,0 +1,189 @@
+/*
+	@file TextureOutline.cpp
+*/
+#include "TextureOutline.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Texture {
+
+namespace /* unnamed */ {
+
+/*
+	2̃xNg̊O(z)vZ.
+*/
+float Cross(const glm::vec2& a, const glm::vec2& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+/*
+	sNZsǂ𒲂ׂ.
+
+	@param image	摜f[^.
+	@param x, y		sNZ̈ʒu.
+
+	@retval true	At@0傫.
+	@retval false	Sɓ.
+*/
+bool IsVisible(const ImageData& image, GLsizei x, GLsizei y)
+{
+	const size_t i = static_cast<size_t>(y) * image.width + x;
+	if (image.type == GL_UNSIGNED_SHORT_1_5_5_5_REV) {
+		return (image.data[i * 2 + 1] & 0x80) != 0;
+	}
+	return image.data[i * 4 + 3] != 0;
+}
+
+/*
+	_̏W͂ޓʕ쐬(Andrew̃mg[E`F[@).
+
+	@param points	_̏W. בւ.
+
+	@return vɕ񂾓ʕ̒_.
+*/
+std::vector<glm::vec2> ConvexHull(std::vector<glm::vec2>& points)
+{
+	std::sort(points.begin(), points.end(), [](const glm::vec2& a, const glm::vec2& b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	std::vector<glm::vec2> hull(points.size() * 2);
+	size_t k = 0;
+	// .
+	for (size_t i = 0; i < points.size(); ++i) {
+		while (k >= 2 && Cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0) {
+			--k;
+		}
+		hull[k++] = points[i];
+	}
+	// 㑤.
+	for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+		while (k >= lower && Cross(hull[k - 1] - hull[k - 2], points[i - 1] - hull[k - 2]) <= 0) {
+			--k;
+		}
+		hull[k++] = points[i - 1];
+	}
+	hull.resize(k - 1);	// Ō̓_͍ŏ̓_Ɠ.
+	return hull;
+}
+
+/*
+	ʑp`̖ʐςvZ.
+*/
+float Area(const std::vector<glm::vec2>& polygon)
+{
+	float area = 0;
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		area += Cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+	}
+	return area * 0.5f;
+}
+
+} // unnamed namespace
+
+/*
+	摜̕sȕ͂ޓʑp`쐬.
+
+	@param image			摜f[^.
+	@param outline			쐬ʑp`i[ϐ.
+							vɕ񂾁A0.0`1.0̃eNX`W.
+	@param maxVertexCount	ʑp`̍ő咸_(3ȏ).
+
+	@retval true	쐬.
+	@retval false	摜ɃAt@ȂASɓA܂͋`ƔׂĖʐς\ɌȂ.
+
+	sƂɗ[̕sȃsNZ߂ēʕAӂ1菜Ē_炷.
+	ӂ菜Ɨׂ̕ӂ_V_ɂȂ̂ŁAp`͏ɓʕ܂.
+	菜ӂ́Aʐςł̂I.
+*/
+bool BuildConvexOutline(const ImageData& image, std::vector<glm::vec2>& outline,
+	size_t maxVertexCount)
+{
+	const bool hasAlpha = image.type == GL_UNSIGNED_SHORT_1_5_5_5_REV ||
+		(image.format == GL_BGRA && image.type == GL_UNSIGNED_BYTE);
+	if (!hasAlpha || image.data.empty() || maxVertexCount < 3) {
+		return false;
+	}
+
+	// sƂɁA[̕sȃsNZ̊pW߂.
+	std::vector<glm::vec2> points;
+	points.reserve(static_cast<size_t>(image.height) * 4);
+	for (GLsizei y = 0; y < image.height; ++y) {
+		GLsizei left = 0;
+		while (left < image.width && !IsVisible(image, left, y)) {
+			++left;
+		}
+		if (left >= image.width) {
+			continue;
+		}
+		GLsizei right = image.width - 1;
+		while (!IsVisible(image, right, y)) {
+			--right;
+		}
+		const float fy = static_cast<float>(y);
+		points.push_back(glm::vec2(static_cast<float>(left), fy));
+		points.push_back(glm::vec2(static_cast<float>(left), fy + 1));
+		points.push_back(glm::vec2(static_cast<float>(right + 1), fy));
+		points.push_back(glm::vec2(static_cast<float>(right + 1), fy + 1));
+	}
+	if (points.empty()) {
+		return false;
+	}
+	std::vector<glm::vec2> polygon = ConvexHull(points);
+
+	// ʐςłӂ菜āA_炷.
+	const glm::vec2 size(static_cast<float>(image.width), static_cast<float>(image.height));
+	while (polygon.size() > maxVertexCount) {
+		const size_t n = polygon.size();
+		size_t bestEdge = n;
+		float bestArea = 0;
+		glm::vec2 bestPoint;
+		for (size_t i = 0; i < n; ++i) {
+			// b-c菜Aa-bƕc-d_pŒu.
+			const glm::vec2& a = polygon[(i + n - 1) % n];
+			const glm::vec2& b = polygon[i];
+			const glm::vec2& c = polygon[(i + 1) % n];
+			const glm::vec2& d = polygon[(i + 2) % n];
+			const glm::vec2 ab = b - a;
+			const glm::vec2 dc = c - d;
+			const float denominator = Cross(ab, dc);
+			if (std::abs(denominator) < 1e-6f) {
+				continue;	// sȕӂ͌Ȃ.
+			}
+			const float t = Cross(c - b, dc) / denominator;
+			const float s = Cross(c - b, ab) / denominator;
+			if (t < 0 || s < 0) {
+				continue;	// ŌȂ.
+			}
+			const glm::vec2 p = b + ab * t;
+			if (p.x < 0 || p.y < 0 || p.x > size.x || p.y > size.y) {
+				continue;	// 摜̊Oɏo钸_͍Ȃ.
+			}
+			const float area = std::abs(Cross(p - b, c - b)) * 0.5f;
+			if (bestEdge == n || area < bestArea) {
+				bestEdge = i;
+				bestArea = area;
+				bestPoint = p;
+			}
+		}
+		if (bestEdge == n) {
+			return false;	// ȏ㒸_点Ȃ.
+		}
+		polygon[bestEdge] = bestPoint;
+		polygon.erase(polygon.begin() + (bestEdge + 1) % n);
+	}
+
+	// _镪Aʐς\ɌȂ΋`̂܂܂ɂ.
+	static const float maxAreaRatio = 0.8f;
+	if (Area(polygon) > size.x * size.y * maxAreaRatio) {
+		return false;
+	}
+
+	outline.resize(polygon.size());
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		outline[i] = polygon[i] / size;
+	}
+	return true;
+}
+
+}	// namespace Texture
@@ -0,0 +1,17 @@
+/*
+	@file TextureOutline.h
+*/
+#ifndef TEXTUREOUTLINE_H_INCLUDED
+#define TEXTUREOUTLINE_H_INCLUDED
+#include "Texture.h"
+#include <glm/vec2.hpp>
+#include <vector>
+
+namespace Texture {
+
+	bool BuildConvexOutline(const ImageData& image, std::vector<glm::vec2>& outline,
+		size_t maxVertexCount = 8);
+
+}	// namespace Texture
+
+#endif // TEXTUREOUTLINE_H_INCLUDED
@@ -0,0 +1,484 @@
+/*
+	@file TextureStreamer.cpp
+*/
+#include "TextureStreamer.h"
+#include "TextureUploader.h"
+#include "TextureOutline.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+namespace Texture {
+
+namespace /* unnamed */ {
+
+/*
+	摜f[^BGRA8`ɕϊ.
+
+	@param image	ϊ摜f[^.
+
+	@return ϊf[^.
+*/
+std::vector<uint8_t> ConvertToBGRA8(const ImageData& image)
+{
+	const size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+	std::vector<uint8_t> result(pixelCount * 4);
+	const uint8_t* src = image.data.data();
+	uint8_t* dst = result.data();
+	if (image.type == GL_UNSIGNED_SHORT_1_5_5_5_REV) {
+		for (size_t i = 0; i < pixelCount; ++i, src += 2, dst += 4) {
+			const uint16_t v = static_cast<uint16_t>(src[0] | (src[1] << 8));
+			dst[0] = static_cast<uint8_t>((v & 0x1f) * 255 / 31);
+			dst[1] = static_cast<uint8_t>(((v >> 5) & 0x1f) * 255 / 31);
+			dst[2] = static_cast<uint8_t>(((v >> 10) & 0x1f) * 255 / 31);
+			dst[3] = (v & 0x8000) ? 255 : 0;
+		}
+	} else if (image.format == GL_RED) {
+		for (size_t i = 0; i < pixelCount; ++i, src += 1, dst += 4) {
+			dst[0] = dst[1] = dst[2] = src[0];
+			dst[3] = 255;
+		}
+	} else if (image.format == GL_BGR) {
+		for (size_t i = 0; i < pixelCount; ++i, src += 3, dst += 4) {
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			dst[3] = 255;
+		}
+	} else {
+		std::copy(src, src + pixelCount * 4, dst);
+	}
+	return result;
+}
+
+/*
+	~bv}bvԂŃeNX`̓eRs[.
+
+	@param src		Rs[eNX`.
+	@param srcBase	Rs[̃~bv}bv0ԂɑΉA摜̃~bv}bvԍ.
+	@param dst		Rs[eNX`.
+	@param dstBase	Rs[̃~bv}bv0ԂɑΉA摜̃~bv}bvԍ.
+	@param image	eNX`̌摜.
+	@param first	Rs[ŏ̌摜̃~bv}bvԍ.
+
+	GPUŃRs[̂ŁACPU̓]͔Ȃ.
+*/
+void CopyLevels(GLuint src, int srcBase, GLuint dst, int dstBase,
+	const StreamingImage2D& image, int first)
+{
+	for (int level = first; level < image.LevelCount(); ++level) {
+		const GLsizei w = std::max(1, image.Width() >> level);
+		const GLsizei h = std::max(1, image.Height() >> level);
+		glCopyImageSubData(src, GL_TEXTURE_2D, level - srcBase, 0, 0, 0,
+			dst, GL_TEXTURE_2D, level - dstBase, 0, 0, 0, w, h, 1);
+	}
+}
+
+} // unnamed namespace
+
+/*
+	t@CXg[~OEeNX`쐬.
+
+	@param path	eNX`t@C.
+
+	@return	쐬eNX`IuWFNg.
+*/
+StreamingImage2DPtr StreamingImage2D::Create(const char* path)
+{
+	ImageData image;
+	LoadImageData(path, image);
+	return Create(image);
+}
+
+/*
+	摜f[^Xg[~OEeNX`쐬.
+
+	@param image	eNX`ɂ摜f[^.
+
+	@return	쐬eNX`IuWFNg.
+*/
+StreamingImage2DPtr StreamingImage2D::Create(const ImageData& image)
+{
+	StreamingImage2DPtr p = std::make_shared<StreamingImage2D>();
+	BuildConvexOutline(image, p->outline);
+	if (p->Init(image)) {
+		Streamer::Instance().Register(p);
+	}
+	return p;
+}
+
+/*
+	~bv}bv쐬A~bv}bvGPUɓ].
+
+	@param image	eNX`ɂ摜f[^.
+
+	@retval true	쐬.
+	@retval false	쐬s.
+*/
+bool StreamingImage2D::Init(const ImageData& image)
+{
+	if (image.data.empty()) {
+		return false;
+	}
+	width = image.width;
+	height = image.height;
+
+	// 2x2sNZ̕ςāA1x1ɂȂ܂Ń~bv}bv쐬.
+	levels.clear();
+	levels.push_back(ConvertToBGRA8(image));
+	for (int level = 1; LevelWidth(level - 1) > 1 || LevelHeight(level - 1) > 1; ++level) {
+		const GLsizei srcW = LevelWidth(level - 1);
+		const GLsizei srcH = LevelHeight(level - 1);
+		const GLsizei w = LevelWidth(level);
+		const GLsizei h = LevelHeight(level);
+		const std::vector<uint8_t>& src = levels.back();
+		std::vector<uint8_t> dst(static_cast<size_t>(w) * h * 4);
+		for (GLsizei y = 0; y < h; ++y) {
+			const GLsizei y0 = std::min(y * 2, srcH - 1);
+			const GLsizei y1 = std::min(y * 2 + 1, srcH - 1);
+			for (GLsizei x = 0; x < w; ++x) {
+				const GLsizei x0 = std::min(x * 2, srcW - 1);
+				const GLsizei x1 = std::min(x * 2 + 1, srcW - 1);
+				for (int c = 0; c < 4; ++c) {
+					const int sum = src[(y0 * srcW + x0) * 4 + c] + src[(y0 * srcW + x1) * 4 + c] +
+						src[(y1 * srcW + x0) * 4 + c] + src[(y1 * srcW + x1) * 4 + c];
+					dst[(y * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+		levels.push_back(std::move(dst));
+	}
+
+	// 64x64ȉ̃~bv}bv͏GPUɒuĂ.
+	static const GLsizei minimumSize = 64;
+	minimumLevel = LevelCount() - 1;
+	for (int level = 0; level < LevelCount(); ++level) {
+		if (LevelWidth(level) <= minimumSize && LevelHeight(level) <= minimumSize) {
+			minimumLevel = level;
+			break;
+		}
+	}
+
+	id = CreateStorage(minimumLevel);
+	++generation;
+	glBindTexture(GL_TEXTURE_2D, id);
+	for (int level = minimumLevel; level < LevelCount(); ++level) {
+		glTexSubImage2D(GL_TEXTURE_2D, level - minimumLevel, 0, 0,
+			LevelWidth(level), LevelHeight(level), GL_BGRA, GL_UNSIGNED_BYTE, levels[level].data());
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+	residentLevel = minimumLevel;
+	desiredLevel = minimumLevel;
+	return id != 0;
+}
+
+/*
+	~bv}bv̕擾.
+
+	@param level	~bv}bvԍ.
+
+	@return (sNZ).
+*/
+GLsizei StreamingImage2D::LevelWidth(int level) const
+{
+	return std::max(1, width >> level);
+}
+
+/*
+	~bv}bv̍擾.
+
+	@param level	~bv}bvԍ.
+
+	@return (sNZ).
+*/
+GLsizei StreamingImage2D::LevelHeight(int level) const
+{
+	return std::max(1, height >> level);
+}
+
+/*
+	GPUɑ݂~bv}bv̍voCg擾.
+
+	@return voCg.
+*/
+size_t StreamingImage2D::ResidentBytes() const
+{
+	size_t total = 0;
+	for (int level = residentLevel; level < LevelCount(); ++level) {
+		total += levels[level].size();
+	}
+	return total;
+}
+
+/*
+	w肵~bv}bvȉi[łeNX`EIuWFNg쐬.
+
+	@param baseLevel	eNX`̃~bv}bv0ԂɂȂA摜̃~bv}bvԍ.
+
+	@return 쐬eNX`EIuWFNgID.
+*/
+GLuint StreamingImage2D::CreateStorage(int baseLevel) const
+{
+	GLuint texId;
+	glGenTextures(1, &texId);
+	glBindTexture(GL_TEXTURE_2D, texId);
+	glTexStorage2D(GL_TEXTURE_2D, LevelCount() - baseLevel, GL_RGBA8,
+		LevelWidth(baseLevel), LevelHeight(baseLevel));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, LevelCount() - baseLevel - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	size_t bytes = 0;
+	for (int level = baseLevel; level < LevelCount(); ++level) {
+		bytes += LevelBytes(level);
+	}
+	GpuResourceRegistry::Instance().Register(GpuResourceType::Texture, texId, bytes,
+		"Texture::StreamingImage2D::CreateStorage");
+	return texId;
+}
+
+/*
+	Xg[}[擾.
+
+	@return Xg[}[̃VOgCX^X.
+*/
+Streamer& Streamer::Instance()
+{
+	static Streamer instance;
+	return instance;
+}
+
+/*
+	fXgN^.
+*/
+Streamer::~Streamer()
+{
+	CancelStreamIn();
+}
+
+/*
+	SẴXg[~OEeNX`GPUɒuĂoCg擾.
+
+	@return voCg.
+*/
+size_t Streamer::ResidentBytes() const
+{
+	size_t total = 0;
+	for (const auto& e : textures) {
+		if (const StreamingImage2DPtr p = e.lock()) {
+			total += p->ResidentBytes();
+		}
+	}
+	return total;
+}
+
+/*
+	Xg[~OEeNX`o^.
+
+	@param p	o^eNX`.
+
+	StreamingImage2D::Create()Ă΂.
+*/
+void Streamer::Register(const StreamingImage2DPtr& p)
+{
+	textures.push_back(p);
+}
+
+/*
+	~bv}bv̓]Ɖs.
+
+	t[1Ăяo.
+*/
+void Streamer::Update()
+{
+	// jꂽeNX`菜.
+	textures.erase(std::remove_if(textures.begin(), textures.end(),
+		[](const std::weak_ptr<StreamingImage2D>& e) { return e.expired(); }), textures.end());
+
+	UpdateDesiredLevels();
+
+	// Kvȏ̃~bv}bv.
+	for (const auto& e : textures) {
+		const StreamingImage2DPtr p = e.lock();
+		if (p->desiredLevel > p->residentLevel) {
+			Evict(*p);
+		}
+	}
+
+	// ]̃~bv}bvȂ΁Ał𑜓xsĂeNX`̓]n߂.
+	if (!pending.texture) {
+		StreamingImage2D* target = nullptr;
+		int maxShortage = 0;
+		for (const auto& e : textures) {
+			const StreamingImage2DPtr p = e.lock();
+			const int shortage = p->residentLevel - p->desiredLevel;
+			if (shortage > maxShortage) {
+				maxShortage = shortage;
+				target = p.get();
+			}
+		}
+		if (!target) {
+			return;
+		}
+		BeginStreamIn(*target);
+	}
+	ContinueStreamIn();
+}
+
+/*
+	eeNX`ɕKvȃ~bv}bvԍvZ.
+
+	`摤񍐂ꂽ𑜓xɂAGPU̗\Z𒴂ꍇ
+	ő𑜓x̃~bv}bv傫̂1iK𑜓x.
+*/
+void Streamer::UpdateDesiredLevels()
+{
+	// ̐̃t[̊ԕ`悳Ȃ΁Aŏ̃~bv}bvɂ.
+	static const int unusedFrameLimit = 60;
+
+	size_t total = 0;
+	for (const auto& e : textures) {
+		StreamingImage2D& tex = *e.lock();
+		tex.unusedFrames = tex.isUsed ? 0 : tex.unusedFrames + 1;
+		tex.isUsed = false;
+
+		// 񍐂Ȃt[͑O̒lg(ێ[hŕω̂ȂXvCĝ).
+		if (tex.screenSize > 0) {
+			tex.requiredSize = tex.screenSize;
+			tex.screenSize = 0;
+		}
+
+		int level = tex.minimumLevel;
+		if (tex.unusedFrames < unusedFrameLimit && tex.requiredSize > 0) {
+			const float fullSize = static_cast<float>(std::max(tex.Width(), tex.Height()));
+			const int n = static_cast<int>(std::floor(std::log2(fullSize / tex.requiredSize)));
+			level = std::min(std::max(n, 0), tex.minimumLevel);
+		}
+		tex.desiredLevel = level;
+		for (int i = level; i < tex.LevelCount(); ++i) {
+			total += tex.LevelBytes(i);
+		}
+	}
+
+	while (total > budget) {
+		StreamingImage2D* target = nullptr;
+		for (const auto& e : textures) {
+			StreamingImage2D* p = e.lock().get();
+			if (p->desiredLevel < p->minimumLevel &&
+				(!target || p->LevelBytes(p->desiredLevel) > target->LevelBytes(target->desiredLevel))) {
+				target = p;
+			}
+		}
+		if (!target) {
+			break;
+		}
+		total -= target->LevelBytes(target->desiredLevel);
+		++target->desiredLevel;
+	}
+}
+
+/*
+	Kvȏ̃~bv}bv.
+
+	@param tex	eNX`.
+
+	Kvȃ~bv}bvi[łeNX`蒼AGPUŃRs[.
+*/
+void Streamer::Evict(StreamingImage2D& tex)
+{
+	if (pending.target.lock().get() == &tex) {
+		CancelStreamIn();
+	}
+	const GLuint newId = tex.CreateStorage(tex.desiredLevel);
+	CopyLevels(tex.id, tex.residentLevel, newId, tex.desiredLevel, tex, tex.desiredLevel);
+	GpuResourceRegistry& registry = GpuResourceRegistry::Instance();
+	registry.Inherit(GpuResourceType::Texture, newId, tex.id);
+	registry.Unregister(GpuResourceType::Texture, tex.id);
+	glDeleteTextures(1, &tex.id);
+	tex.id = newId;
+	++tex.generation;
+	tex.residentLevel = tex.desiredLevel;
+}
+
+/*
+	1iK傫~bv}bv̓]Jn.
+
+	@param tex	]eNX`.
+
+	]̃eNX`쐬Ã~bv}bvRs[Ă.
+	]I܂ł́ÃeNX``Ɏg.
+*/
+void Streamer::BeginStreamIn(StreamingImage2D& tex)
+{
+	const int level = tex.residentLevel - 1;
+	pending.texture = tex.CreateStorage(level);
+	CopyLevels(tex.id, tex.residentLevel, pending.texture, level, tex, tex.residentLevel);
+	pending.level = level;
+	pending.row = 0;
+	for (const auto& e : textures) {
+		if (e.lock().get() == &tex) {
+			pending.target = e;
+			break;
+		}
+	}
+}
+
+/*
+	]̃~bv}bvA1t[̓]ʂ].
+
+	@retval true	]AeNX`u.
+	@retval false	]A܂͒~.
+
+	Uploader̃sNZobt@oRčsPʂœ]̂ŁA傫ȃ~bv}bv͕t[ɕ.
+*/
+bool Streamer::ContinueStreamIn()
+{
+	const StreamingImage2DPtr tex = pending.target.lock();
+	if (!tex) {
+		CancelStreamIn();
+		return false;
+	}
+	const GLsizei w = tex->LevelWidth(pending.level);
+	const GLsizei h = tex->LevelHeight(pending.level);
+	const size_t rowBytes = static_cast<size_t>(w) * 4;
+	const GLsizei rows = std::min<GLsizei>(h - pending.row,
+		std::max<GLsizei>(1, static_cast<GLsizei>(uploadBytesPerFrame / rowBytes)));
+	const GLsizei uploaded = Uploader::Instance().UploadRows(pending.texture, 0, w, pending.row,
+		rows, GL_BGRA, GL_UNSIGNED_BYTE, tex->levels[pending.level].data());
+
+	pending.row += uploaded;
+	if (pending.row < h) {
+		return false;
+	}
+
+	// ]ÎŁAeNX`u.
+	GpuResourceRegistry& registry = GpuResourceRegistry::Instance();
+	registry.Inherit(GpuResourceType::Texture, pending.texture, tex->id);
+	registry.Unregister(GpuResourceType::Texture, tex->id);
+	glDeleteTextures(1, &tex->id);
+	tex->id = pending.texture;
+	++tex->generation;
+	tex->residentLevel = pending.level;
+	pending.texture = 0;
+	pending.target.reset();
+	return true;
+}
+
+/*
+	]̃~bv}bv̓]𒆎~.
+*/
+void Streamer::CancelStreamIn()
+{
+	if (pending.texture) {
+		GpuResourceRegistry::Instance().Unregister(GpuResourceType::Texture, pending.texture);
+		glDeleteTextures(1, &pending.texture);
+		pending.texture = 0;
+	}
+	pending.target.reset();
+}
+
+}	// namespace Texture
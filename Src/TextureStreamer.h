@@ -0,0 +1,98 @@
+/*
+	@file TextureStreamer.h
+*/
+#ifndef TEXTURESTREAMER_H_INCLUDED
+#define TEXTURESTREAMER_H_INCLUDED
+#include "Texture.h"
+#include <vector>
+#include <memory>
+
+namespace Texture {
+
+	class StreamingImage2D;
+	using StreamingImage2DPtr = std::shared_ptr<StreamingImage2D>;
+
+	/*
+		~bv}bvPʂœǂݍ݂Ɖs2DeNX`.
+
+		쐬ɂ͏~bv}bvGPUɓ]A
+		ʏŕKvȉ𑜓xɉāA傫~bv}bvStreamer].
+		Width()Height()͏ɍő𑜓x̑傫Ԃ.
+	*/
+	class StreamingImage2D : public Image2D
+	{
+		friend class Streamer;
+	public:
+		static StreamingImage2DPtr Create(const char* path);
+		static StreamingImage2DPtr Create(const ImageData&);
+		StreamingImage2D() = default;
+		virtual ~StreamingImage2D() = default;
+
+		int LevelCount() const { return static_cast<int>(levels.size()); }
+		int ResidentLevel() const { return residentLevel; }
+		int DesiredLevel() const { return desiredLevel; }
+		size_t LevelBytes(int level) const { return levels[level].size(); }
+		size_t ResidentBytes() const;
+
+	private:
+		bool Init(const ImageData&);
+		GLsizei LevelWidth(int level) const;
+		GLsizei LevelHeight(int level) const;
+		GLuint CreateStorage(int baseLevel) const;
+
+		std::vector<std::vector<uint8_t>> levels;	///< S~bv}bvBGRA8f[^.
+		int residentLevel = 0;	///< GPUɑ݂ő𑜓x̃~bv}bvԍ.
+		int desiredLevel = 0;	///< KvƂő𑜓x̃~bv}bvԍ.
+		int minimumLevel = 0;	///< GPUɒuĂ~bv}bvԍ.
+		float requiredSize = 0;	///< Ōɕ񍐂ꂽKv𑜓x.
+		int unusedFrames = 0;	///< `ɎgȂAt[.
+	};
+
+	/*
+		StreamingImage2D̃~bv}bv̓]ƉǗNX.
+
+		Update()𖈃t[Ăяo.
+		GPU̗\Z𒴂ꍇ́AKv𑜓xɑ΂ĉ𑜓xߏȃeNX`
+		傫~bv}bv.
+	*/
+	class Streamer
+	{
+	public:
+		static Streamer& Instance();
+
+		void Budget(size_t bytes) { budget = bytes; }
+		size_t Budget() const { return budget; }
+		void UploadBytesPerFrame(size_t bytes) { uploadBytesPerFrame = bytes; }
+		size_t ResidentBytes() const;
+
+		void Register(const StreamingImage2DPtr&);
+		void Update();
+
+	private:
+		Streamer() = default;
+		~Streamer();
+		Streamer(const Streamer&) = delete;
+		Streamer& operator=(const Streamer&) = delete;
+
+		void UpdateDesiredLevels();
+		void Evict(StreamingImage2D&);
+		void BeginStreamIn(StreamingImage2D&);
+		bool ContinueStreamIn();
+		void CancelStreamIn();
+
+		std::vector<std::weak_ptr<StreamingImage2D>> textures;
+		size_t budget = 256 * 1024 * 1024;		///< GPU̗\Z(oCg).
+		size_t uploadBytesPerFrame = 1024 * 1024;	///< 1t[œ]őoCg.
+
+		// ]̃~bv}bv.
+		struct {
+			std::weak_ptr<StreamingImage2D> target;
+			GLuint texture = 0;	///< ]IueNX`.
+			int level = 0;		///< ]̃~bv}bvԍ.
+			GLsizei row = 0;	///< ɓ]s.
+		} pending;
+	};
+
+}	// namespace Texture
+
+#endif // TEXTURESTREAMER_H_INCLUDED
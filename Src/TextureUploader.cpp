@@ -0,0 +1,141 @@
+/*
+	@file TextureUploader.cpp
+*/
+#include "TextureUploader.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <iostream>
+#include <string.h>
+
+namespace Texture {
+
+namespace /* unnamed */ {
+
+/*
+	1sNZ̃oCg擾.
+
+	@param format	f[^`.
+	@param type		vf̌^.
+
+	@return 1sNZ̃oCg.
+*/
+size_t BytesPerPixel(GLenum format, GLenum type)
+{
+	if (type == GL_UNSIGNED_SHORT_1_5_5_5_REV) {
+		return 2;
+	}
+	switch (format) {
+	case GL_RED: return 1;
+	case GL_BGR: return 3;
+	default: return 4;
+	}
+}
+
+} // unnamed namespace
+
+/*
+	Abv[_[擾.
+
+	@return Abv[_[̃VOgCX^X.
+*/
+Uploader& Uploader::Instance()
+{
+	static Uploader instance;
+	return instance;
+}
+
+/*
+	fXgN^.
+*/
+Uploader::~Uploader()
+{
+	for (PixelBuffer& e : buffers) {
+		if (e.fence) {
+			glDeleteSync(e.fence);
+		}
+	}
+}
+
+/*
+	󂢂ĂsNZobt@T.
+
+	@return 󂢂ĂsNZobt@ւ̃|C^.
+			SĎgpȂnullptr.
+*/
+Uploader::PixelBuffer* Uploader::FindFreeBuffer()
+{
+	for (PixelBuffer& e : buffers) {
+		if (e.fence) {
+			const GLenum result = glClientWaitSync(e.fence, 0, 0);
+			if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+				continue;
+			}
+			glDeleteSync(e.fence);
+			e.fence = 0;
+		}
+		if (!e.buffer.Id()) {
+			GpuResourceRegistry::OwnerScope owner("Texture::Uploader");
+			e.buffer.Create(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+		}
+		return &e;
+	}
+	return nullptr;
+}
+
+/*
+	摜̈ꕔ̍sAsNZobt@oRŃeNX`ɓ].
+
+	@param texture	]eNX`.
+	@param level	]̃~bv}bvԍ.
+	@param width	摜̕(sNZ).
+	@param row		]Jns.
+	@param rowCount	]s.
+	@param format	摜̃f[^`.
+	@param type		摜̗vf̌^.
+	@param data		摜̐擪sւ̃|C^.
+
+	@return ۂɓ]s.
+			󂢂ĂsNZobt@Ȃꍇ0.
+
+	1̃sNZobt@Ɏ܂s]̂ŁAc͍ēxĂяo.
+*/
+GLsizei Uploader::UploadRows(GLuint texture, GLint level, GLsizei width, GLint row,
+	GLsizei rowCount, GLenum format, GLenum type, const uint8_t* data)
+{
+	const size_t rowBytes = width * BytesPerPixel(format, type);
+	if (rowBytes > static_cast<size_t>(bufferSize)) {
+		std::cerr << "[G[]" << __func__ << ": 1ssNZobt@傫(" <<
+			rowBytes << "oCg).\n";
+		return 0;
+	}
+	PixelBuffer* pb = FindFreeBuffer();
+	if (!pb) {
+		return 0;
+	}
+	rowCount = std::min(rowCount, static_cast<GLsizei>(bufferSize / rowBytes));
+	const size_t bytes = rowBytes * rowCount;
+
+	// GPU̓ǂݍ݂̓tFXŊmFς݂Ȃ̂ŁAȂŏ߂.
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pb->buffer.Id());
+	void* p = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (!p) {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		std::cerr << "[G[]" << __func__ << ": sNZobt@̃}bvɎs.\n";
+		return 0;
+	}
+	memcpy(p, data + rowBytes * row, bytes);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, level, 0, row, width, rowCount, format, type, nullptr);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	pb->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return rowCount;
+}
+
+}	// namespace Texture
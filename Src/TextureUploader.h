@@ -0,0 +1,48 @@
+/*
+	@file TextureUploader.h
+*/
+#ifndef TEXTUREUPLOADER_H_INCLUDED
+#define TEXTUREUPLOADER_H_INCLUDED
+#include "Texture.h"
+#include "BufferObject.h"
+
+namespace Texture {
+
+	/*
+		sNZobt@gāAeNX`񓯊ɓ]NX.
+
+		摜f[^𕡐̃sNZobt@ɕăRs[AglTexSubImage2D
+		sNZobt@s邱ƂŁA]`ƕsčs.
+		sNZobt@̓tFXGPU̓ǂݍ݊mFĂėp.
+		StreamingImage2D̃~bv}bv̓]Ɏg.
+	*/
+	class Uploader
+	{
+	public:
+		static Uploader& Instance();
+
+		GLsizei UploadRows(GLuint texture, GLint level, GLsizei width, GLint row, GLsizei rowCount,
+			GLenum format, GLenum type, const uint8_t* data);
+
+	private:
+		Uploader() = default;
+		~Uploader();
+		Uploader(const Uploader&) = delete;
+		Uploader& operator=(const Uploader&) = delete;
+
+		// sNZobt@.
+		struct PixelBuffer
+		{
+			BufferObject buffer;	///< ]f[^i[obt@.
+			GLsync fence = 0;		///< GPUǂݍ݂IʒmtFX.
+		};
+		PixelBuffer* FindFreeBuffer();
+
+		static const size_t bufferCount = 4;			///< sNZobt@̐.
+		static const GLsizeiptr bufferSize = 2 * 1024 * 1024;	///< 1̃sNZobt@̃oCg.
+		PixelBuffer buffers[bufferCount];
+	};
+
+}	// namespace Texture
+
+#endif // TEXTUREUPLOADER_H_INCLUDED
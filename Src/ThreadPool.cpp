@@ -0,0 +1,116 @@
+/*
+	@file ThreadPool.cpp
+*/
+#include "ThreadPool.h"
+
+/*
+	fXgN^.
+*/
+ThreadPool::~ThreadPool()
+{
+	Resize(0);
+}
+
+/*
+	ƃXbh̐ύX.
+
+	@param workerCount	ƃXbh̐. 0ȂĂяoXbhŎs.
+
+	̍ƃXbh͑SďIĂ蒼. Run()̎sɌĂяoȂ.
+*/
+void ThreadPool::Resize(size_t workerCount)
+{
+	if (workerCount == workers.size()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isQuitting = true;
+	}
+	startCondition.notify_all();
+	for (std::thread& e : workers) {
+		e.join();
+	}
+	workers.clear();
+	isQuitting = false;
+
+	workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		workers.emplace_back(&ThreadPool::WorkerMain, this);
+	}
+}
+
+/*
+	d𕪒SĎs.
+
+	@param taskCount	d̐.
+	@param task			d̔ԍ(0`taskCount-1)󂯎Ďs֐.
+
+	ǂ̎dǂ̃XbhŎs邩͌܂ĂȂ.
+	SĂ̎dI܂Ŗ߂Ȃ. ɕ̃XbhĂяoȂ.
+*/
+void ThreadPool::Run(size_t taskCount, const std::function<void(size_t)>& task)
+{
+	if (workers.empty() || taskCount <= 1) {
+		for (size_t i = 0; i < taskCount; ++i) {
+			task(i);
+		}
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = &task;
+		this->taskCount = taskCount;
+		nextTask = 0;
+		runningWorkers = workers.size();
+		++runCount;
+	}
+	startCondition.notify_all();
+	Execute();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this]() { return runningWorkers == 0; });
+	this->task = nullptr;
+}
+
+/*
+	ƃXbh̏.
+
+	Vd܂őҋ@AdcĂԂ͎s𑱂.
+*/
+void ThreadPool::WorkerMain()
+{
+	uint64_t lastRunCount = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		lastRunCount = runCount;
+	}
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock,
+				[this, lastRunCount]() { return isQuitting || runCount != lastRunCount; });
+			if (isQuitting) {
+				return;
+			}
+			lastRunCount = runCount;
+		}
+		Execute();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--runningWorkers == 0) {
+				doneCondition.notify_one();
+			}
+		}
+	}
+}
+
+/*
+	s̎d1oĎs.
+*/
+void ThreadPool::Execute()
+{
+	for (size_t i = nextTask++; i < taskCount; i = nextTask++) {
+		(*task)(i);
+	}
+}
@@ -0,0 +1,51 @@
+/*
+	@file ThreadPool.h
+*/
+#ifndef THREADPOOL_H_INCLUDED
+#define THREADPOOL_H_INCLUDED
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+	t[̕񏈗ɎgƃXbh̏W܂.
+
+	Xbh͍쐬܂ܑҋ@ĂARun()̂тɋNĎd𕪒S.
+	std::asynĉ悤ɌĂяoƂɃXbhȂ̂ŁAZł񉻂̌ʂo₷.
+	Run()͌ĂяoXbhd𕪒SASĂ̎dI܂Ŗ߂Ȃ.
+*/
+class ThreadPool
+{
+public:
+	ThreadPool() = default;
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Resize(size_t workerCount);
+	size_t WorkerCount() const { return workers.size(); }
+	void Run(size_t taskCount, const std::function<void(size_t)>& task);
+
+private:
+	void WorkerMain();
+	void Execute();
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable startCondition;	///< d̊JnƏIvƃXbhɒm点.
+	std::condition_variable doneCondition;	///< SĂ̍ƃXbhIƂm点.
+
+	const std::function<void(size_t)>* task = nullptr;	///< s̎d.
+	size_t taskCount = 0;					///< s̎d̐.
+	std::atomic<size_t> nextTask{ 0 };		///< Ɏsd̔ԍ.
+	size_t runningWorkers = 0;				///< dIĂȂƃXbh̐.
+	uint64_t runCount = 0;					///< Run()̌Ăяo. Vd̔Ɏg.
+	bool isQuitting = false;				///< ƃXbhI邩.
+};
+
+#endif // THREADPOOL_H_INCLUDED
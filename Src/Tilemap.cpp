@@ -0,0 +1,296 @@
+/*
+	@file Tilemap.cpp
+*/
+#include "Tilemap.h"
+#include "QuadIndexBuffer.h"
+#include "GpuResourceRegistry.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+/*
+	^C}bv.
+
+	@param tileset	^CׂeNX`.
+	@param tileSize	^C̑傫(sNZ). \TCYɂȂ.
+	@param width	}bv̕(^C).
+	@param height	}bv̍(^C).
+	@param vsPath	_VF[_[t@C.
+	@param fsPath	tOgVF[_[t@C.
+
+	@retval true	.
+	@retval false	s.
+
+	^Cԍ̓eNX`̍ォEɌĐAE[ɒB1iɐi.
+	SẴ^CemptyTileŏ.
+*/
+bool Tilemap::Init(const Texture::Image2DPtr& tileset, const glm::vec2& tileSize,
+	int width, int height, const char* vsPath, const char* fsPath)
+{
+	if (!tileset || tileSize.x <= 0 || tileSize.y <= 0 || width <= 0 || height <= 0) {
+		std::cerr << "[G[]" << __func__ << ": sł.\n";
+		return false;
+	}
+	this->tileset = tileset;
+	this->tileSize = tileSize;
+	this->width = width;
+	this->height = height;
+	chunkCountX = (width + chunkSize - 1) / chunkSize;
+	chunkCountY = (height + chunkSize - 1) / chunkSize;
+	tiles.assign(static_cast<size_t>(width) * height, emptyTile);
+	chunks.clear();
+	chunks.reserve(static_cast<size_t>(chunkCountX) * chunkCountY);
+	for (int i = 0; i < chunkCountX * chunkCountY; ++i) {
+		chunks.push_back(std::make_unique<Chunk>());
+	}
+
+	// `N̎lp`̃CfbNX́AXvCgƋL.
+	QuadIndexBuffer::Instance().Reserve(chunkSize * chunkSize);
+
+	Shader::Permutation textured;
+	textured.features = Shader::Feature_Textured;
+	program = Shader::ProgramCache::Instance().Get(vsPath, fsPath, textured);
+	return program && program->Id();
+}
+
+/*
+	^Cݒ肷.
+
+	@param x, y		^C̈ʒu(0, 0).
+	@param index	^Cԍ. emptyTileȂ^C.
+*/
+void Tilemap::Tile(int x, int y, uint16_t index)
+{
+	if (x < 0 || y < 0 || x >= width || y >= height) {
+		return;
+	}
+	uint16_t& tile = tiles[static_cast<size_t>(y) * width + x];
+	if (tile != index) {
+		tile = index;
+		chunks[(y / chunkSize) * chunkCountX + x / chunkSize]->isDirty = true;
+	}
+}
+
+/*
+	^C擾.
+
+	@param x, y	^C̈ʒu(0, 0).
+
+	@return ^Cԍ. }bv̊OȂemptyTile.
+*/
+uint16_t Tilemap::Tile(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= width || y >= height) {
+		return emptyTile;
+	}
+	return tiles[static_cast<size_t>(y) * width + x];
+}
+
+/*
+	}bv̈ʒuݒ肷.
+
+	@param p	^C(0, 0)̍̍W.
+
+	_f[^ɍW܂܂邽߁ASẴ`N蒼.
+*/
+void Tilemap::Origin(const glm::vec3& p)
+{
+	origin = p;
+	for (std::unique_ptr<Chunk>& e : chunks) {
+		e->isDirty = true;
+	}
+}
+
+/*
+	^CύXꂽ`N̒_f[^蒼.
+*/
+void Tilemap::Update()
+{
+	for (int y = 0; y < chunkCountY; ++y) {
+		for (int x = 0; x < chunkCountX; ++x) {
+			if (chunks[y * chunkCountX + x]->isDirty) {
+				Bake(x, y);
+			}
+		}
+	}
+}
+
+/*
+	`N̒_f[^쐬AVBOɓ].
+
+	@param chunkX, chunkY	`N̈ʒu.
+
+	VBO͎lp`̐Ƃ蒼. 蒼ꍇ̓`NŜ܂傫ō쐬A
+	Ȍ̕ύXłBufferSubDataŏ㏑.
+*/
+void Tilemap::Bake(int chunkX, int chunkY)
+{
+	Chunk& chunk = *chunks[chunkY * chunkCountX + chunkX];
+	chunk.isDirty = false;
+
+	const int tilesPerRow = std::max(1, static_cast<int>(tileset->Width() / tileSize.x));
+	const glm::vec2 reciprocalSize =
+		glm::vec2(1) / glm::vec2(tileset->Width(), tileset->Height());
+	const glm::vec2 texSize = tileSize * reciprocalSize;
+	const glm::vec4 color(1);
+
+	bakeBuffer.clear();
+	const int endX = std::min((chunkX + 1) * chunkSize, width);
+	const int endY = std::min((chunkY + 1) * chunkSize, height);
+	for (int y = chunkY * chunkSize; y < endY; ++y) {
+		for (int x = chunkX * chunkSize; x < endX; ++x) {
+			const uint16_t tile = tiles[static_cast<size_t>(y) * width + x];
+			if (tile == emptyTile) {
+				continue;
+			}
+			// ^Cԍ͍ォ琔̂ŁAeNX`W(_)ł͏ォ牺ɐi.
+			const glm::vec2 texOrigin = glm::vec2(
+				static_cast<float>(tile % tilesPerRow) * texSize.x,
+				1.0f - static_cast<float>(tile / tilesPerRow + 1) * texSize.y);
+			const glm::vec3 p0 = origin + glm::vec3(x * tileSize.x, y * tileSize.y, 0);
+			const glm::vec3 p1 = p0 + glm::vec3(tileSize, 0);
+			bakeBuffer.push_back({ p0, color, glm::vec3(texOrigin, 0) });
+			bakeBuffer.push_back({ glm::vec3(p1.x, p0.y, p0.z), color,
+				glm::vec3(texOrigin.x + texSize.x, texOrigin.y, 0) });
+			bakeBuffer.push_back({ p1, color, glm::vec3(texOrigin + texSize, 0) });
+			bakeBuffer.push_back({ glm::vec3(p0.x, p1.y, p0.z), color,
+				glm::vec3(texOrigin.x, texOrigin.y + texSize.y, 0) });
+		}
+	}
+	chunk.quadCount = static_cast<GLsizei>(bakeBuffer.size() / 4);
+	if (bakeBuffer.empty()) {
+		return;
+	}
+
+	const GLsizeiptr bytes = static_cast<GLsizeiptr>(bakeBuffer.size() * sizeof(Vertex));
+	if (bytes <= chunk.vbo.Size()) {
+		chunk.vbo.BufferSubData(0, bytes, bakeBuffer.data());
+		return;
+	}
+
+	// ͕Kvȑ傫A2ڈȍ~̓`NŜ܂傫ō쐬.
+	GLsizeiptr capacity = bytes;
+	if (chunk.vbo.Id()) {
+		capacity = static_cast<GLsizeiptr>(chunkSize * chunkSize * 4 * sizeof(Vertex));
+	}
+	GPU_RESOURCE_SITE();
+	chunk.vbo.Create(GL_ARRAY_BUFFER, capacity, nullptr, GL_STATIC_DRAW);
+	chunk.vbo.BufferSubData(0, bytes, bakeBuffer.data());
+	chunk.vao.Create(chunk.vbo.Id(), QuadIndexBuffer::Instance().Id());
+	chunk.vao.Bind();
+	chunk.vao.VertexAttribPointer(
+		0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, position));
+	chunk.vao.VertexAttribPointer(
+		1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, color));
+	chunk.vao.VertexAttribPointer(
+		2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, texCoord));
+	chunk.vao.Unbind();
+}
+
+/*
+	J̕\͈͂ƏdȂ`N͈̔͂߂.
+
+	@param camera	`ɎgpJ.
+	@param first	͈͂̍ŏ̃`Nʒui[ϐ.
+	@param last		͈͂̍ő̃`Nʒui[ϐ.
+
+	@retval true	dȂ`N.
+	@retval false	dȂ`NȂ.
+*/
+bool Tilemap::VisibleChunks(const Camera2D& camera, glm::ivec2& first, glm::ivec2& last) const
+{
+	if (chunks.empty()) {
+		return false;
+	}
+	const Rect& view = camera.VisibleRect();
+	const glm::vec2 chunkWorldSize = tileSize * static_cast<float>(chunkSize);
+	const glm::vec2 offset(origin.x, origin.y);
+	const glm::vec2 p0 = (view.origin - offset) / chunkWorldSize;
+	const glm::vec2 p1 = (view.origin + view.size - offset) / chunkWorldSize;
+	first = glm::ivec2(std::max(0, static_cast<int>(std::floor(p0.x))),
+		std::max(0, static_cast<int>(std::floor(p0.y))));
+	last = glm::ivec2(std::min(chunkCountX - 1, static_cast<int>(std::floor(p1.x))),
+		std::min(chunkCountY - 1, static_cast<int>(std::floor(p1.y))));
+	return first.x <= last.x && first.y <= last.y;
+}
+
+/*
+	J猩`N`悷.
+
+	@param camera	`ɎgpJ.
+
+	r[|[g̓J̐ݒɕύX.
+*/
+void Tilemap::Draw(const Camera2D& camera) const
+{
+	drawnChunkCount = 0;
+	glm::ivec2 first, last;
+	if (!VisibleChunks(camera, first, last)) {
+		return;
+	}
+
+	camera.ApplyViewport();
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	program->Use();
+	program->SetViewProjectionMatrix(camera.ViewProjectionMatrix());
+	program->BindTexture(0, tileset->Get());
+	tileset->MarkUsed();
+	tileset->ReportScreenSize(
+		static_cast<float>(std::max(tileset->Width(), tileset->Height())) * camera.Zoom());
+	for (int y = first.y; y <= last.y; ++y) {
+		for (int x = first.x; x <= last.x; ++x) {
+			const Chunk& chunk = *chunks[y * chunkCountX + x];
+			if (chunk.quadCount == 0) {
+				continue;
+			}
+			chunk.vao.Bind();
+			glDrawElements(GL_TRIANGLES, chunk.quadCount * 6, GL_UNSIGNED_SHORT, nullptr);
+			++drawnChunkCount;
+		}
+	}
+	glBindVertexArray(0);
+	program->BindTexture(0, 0);
+}
+
+/*
+	J猩`N̕`R}h쐬.
+
+	@param buffer	R}hǉobt@.
+	@param camera	`ɎgpJ.
+	@param layer	`惌C[.
+*/
+void Tilemap::Draw(RenderCommandBuffer& buffer, const Camera2D& camera, uint8_t layer) const
+{
+	drawnChunkCount = 0;
+	glm::ivec2 first, last;
+	if (!VisibleChunks(camera, first, last)) {
+		return;
+	}
+
+	tileset->MarkUsed();
+	tileset->ReportScreenSize(
+		static_cast<float>(std::max(tileset->Width(), tileset->Height())) * camera.Zoom());
+	const uint16_t view = buffer.AddView(camera.ViewProjectionMatrix(), camera.Viewport());
+	for (int y = first.y; y <= last.y; ++y) {
+		for (int x = first.x; x <= last.x; ++x) {
+			const Chunk& chunk = *chunks[y * chunkCountX + x];
+			if (chunk.quadCount == 0) {
+				continue;
+			}
+			RenderCommand command;
+			command.depthBase = buffer.AllocateDepth(layer, chunk.quadCount);
+			command.sortKey = RenderCommandBuffer::MakeSortKey(layer, program->Id(),
+				tileset->Get(), static_cast<uint32_t>(command.depthBase));
+			command.program = program.get();
+			command.vao = chunk.vao.Id();
+			command.texture = tileset->Get();
+			command.count = chunk.quadCount * 6;
+			command.offset = 0;
+			command.view = view;
+			buffer.Add(command);
+			++drawnChunkCount;
+		}
+	}
+}
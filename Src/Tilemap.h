@@ -0,0 +1,79 @@
+/*
+	@file Tilemap.h
+*/
+#ifndef TILEMAP_H_INCLUDED
+#define TILEMAP_H_INCLUDED
+#include "BufferObject.h"
+#include "Texture.h"
+#include "Shader.h"
+#include "Camera2D.h"
+#include "RenderCommandBuffer.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+/*
+	^C}bv.
+
+	}bvchunkSize x chunkSize^C̃`NɕA`NƂɒ_f[^
+	ÓIVBOɍ쐬Ă. t[ׂ̓̕^Cł͂ȂA\`N̐ɔႷ.
+	^CύX`NAUpdate()ō蒼.
+*/
+class Tilemap
+{
+public:
+	static const uint16_t emptyTile = 0xffff;	///< ^CȂƂԍ.
+	static const int chunkSize = 32;			///< `N̈ӂ̃^C.
+
+	Tilemap() = default;
+	~Tilemap() = default;
+	Tilemap(const Tilemap&) = delete;
+	Tilemap& operator=(const Tilemap&) = delete;
+
+	bool Init(const Texture::Image2DPtr& tileset, const glm::vec2& tileSize,
+		int width, int height, const char* vsPath, const char* fsPath);
+	void Tile(int x, int y, uint16_t index);
+	uint16_t Tile(int x, int y) const;
+	void Origin(const glm::vec3&);
+	const glm::vec3& Origin() const { return origin; }
+	int Width() const { return width; }
+	int Height() const { return height; }
+
+	void Update();
+	void Draw(const Camera2D&) const;
+	void Draw(RenderCommandBuffer&, const Camera2D&, uint8_t layer) const;
+
+	// O̕`ŕ`悵`N̐.
+	size_t DrawnChunkCount() const { return drawnChunkCount; }
+
+private:
+	struct Vertex {
+		glm::vec3 position;	///< W.
+		glm::vec4 color;	///< F(Zς݃At@).
+		glm::vec3 texCoord;	///< eNX`W. SpriteRendererƓVF[_[g3vf.
+	};
+	struct Chunk {
+		BufferObject vbo;
+		VertexArrayObject vao;
+		GLsizei quadCount = 0;	///< łȂ^C̐.
+		bool isDirty = true;	///< _f[^蒼Kv邩.
+	};
+	void Bake(int chunkX, int chunkY);
+	bool VisibleChunks(const Camera2D&, glm::ivec2& first, glm::ivec2& last) const;
+
+	Texture::Image2DPtr tileset;	///< ^CׂeNX`.
+	Shader::ProgramPtr program;
+	glm::vec2 tileSize = glm::vec2(0);	///< ^C̑傫(sNZ).
+	glm::vec3 origin = glm::vec3(0);	///< ^C(0, 0)̍̍W.
+	int width = 0;		///< }bv̕(^C).
+	int height = 0;		///< }bv̍(^C).
+	int chunkCountX = 0;
+	int chunkCountY = 0;
+	std::vector<uint16_t> tiles;	///< ^Cԍ(width * height).
+	std::vector<std::unique_ptr<Chunk>> chunks;
+	std::vector<Vertex> bakeBuffer;	///< _f[^쐬p̍Ɨ̈.
+	mutable size_t drawnChunkCount = 0;
+};
+
+#endif // TILEMAP_H_INCLUDED
@@ -4,6 +4,20 @@
 #include "TitleScene.h"
 #include "MainGameScene.h"
 #include "GLFWEW.h"
+#include "TextureStreamer.h"
+
+/*
+	V[̏ɕKvȃt@Cǂݍ.
+
+	@retval true	ǂݍݐ.
+	@retval false	ǂݍݎs.
+
+	obNOEhŎs邱Ƃ̂ŁAOpenGL̊֐͎gȂ.
+*/
+bool TitleScene::Preload()
+{
+	return Texture::LoadImageData("Res/TitleBg.tga", bgImage);
+}
 
 /*
 	V[.
@@ -14,10 +28,13 @@
 bool TitleScene::Initialize()
 {
 	spriteRenderer.Init(1000, "Res/Sprite.vert", "Res/Sprite.frag");
-	sprites.reserve(100);
-	Sprite spr(Texture::Image2D::Create("Res/TitleBg.tga"));
+	const GLFWEW::Window& window = GLFWEW::Window::Instance();
+	camera.Viewport(0, 0, window.Width(), window.Height());
+	sprites.Reserve(100);
+	Sprite spr(Texture::StreamingImage2D::Create(bgImage));
+	bgImage = Texture::ImageData();
 	spr.Scale(glm::vec2(2));
-	sprites.push_back(spr);
+	sprites.Add(spr);
 
 	return true;
 }
@@ -40,11 +57,8 @@ void TitleScene::ProcessInput()
 */
 void TitleScene::Update(float deltaTime)
 {
-	spriteRenderer.BeginUpdate();
-	for (const Sprite& e : sprites) {
-		spriteRenderer.AddVertices(e);
-	}
-	spriteRenderer.EndUpdate();
+	// ύXꂽXvCgXV̂ŁAÎ~Ăwiׂ͂̕قڂȂ.
+	spriteRenderer.UpdateVertices(sprites);
 }
 
 /*
@@ -52,7 +66,5 @@ void TitleScene::Update(float deltaTime)
 */
 void TitleScene::Render()
 {
-	const GLFWEW::Window& window = GLFWEW::Window::Instance();
-	const glm::vec2 screenSize(window.Width(), window.Height());
-	spriteRenderer.Draw(screenSize);
+	spriteRenderer.Draw(SceneStack::Instance().CommandBuffer(), camera, 0);
 }
\ No newline at end of file
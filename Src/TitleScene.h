@@ -5,6 +5,7 @@
 #define TITLESCENE_H_INCLUDED
 #include "Scene.h"
 #include "Sprite.h"
+#include "SpriteBatch.h"
 
 /*
 	^Cg.
@@ -15,6 +16,7 @@ public:
 	TitleScene() : Scene("TitleScene") {}
 	virtual ~TitleScene() = default;
 
+	virtual bool Preload() override;
 	virtual bool Initialize() override;
 	virtual void ProcessInput() override;
 	virtual void Update(float) override;
@@ -22,8 +24,10 @@ public:
 	virtual void Finalize() override {}
 
 private:
-	std::vector<Sprite> sprites;
+	SpriteBatch sprites;
 	SpriteRenderer spriteRenderer;
+	Camera2D camera;
+	Texture::ImageData bgImage;	///< Preload()œǂݍ񂾔wi摜.
 };
 
 #endif // TITLESCENE_H_INCLUDED